@@ -0,0 +1,238 @@
+/*! 
+@file epAsyncExecutor.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Asynchronous Executor Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Asynchronous Executor.
+*/
+#ifndef __EP_ASYNC_EXECUTOR_H__
+#define __EP_ASYNC_EXECUTOR_H__
+
+#include "epOraLib.h"
+#include "epOraDefines.h"
+#include "epQueryJob.h"
+#include <vector>
+
+namespace epol
+{
+	class Connection;
+	class Environment;
+	class SessionPool;
+	class AsyncExecutor;
+
+	/*!
+	@class QueryJobProcessor epAsyncExecutor.h
+	@brief This is a class representing the processor of Query Jobs
+
+	Interface for the job processor, which runs the query jobs of one worker thread on its own connection.
+	*/
+	class EP_ORACLELIB QueryJobProcessor:public epl::BaseJobProcessor
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the processor
+		@param[in] executor the executor the processor works for
+		@param[in] conn the connection to run the jobs on (not owned)
+		*/
+		QueryJobProcessor (AsyncExecutor *executor, Connection *conn);
+
+		/*!
+		Run given query job
+		@param[in] workerThread the worker thread running the job
+		@param[in] data the query job
+		*/
+		virtual void DoJob (epl::BaseWorkerThread *workerThread, epl::BaseJob* const data);
+
+		/*!
+		Return the connection the jobs run on
+		@return the connection of the processor
+		*/
+		inline Connection *GetConnection () const
+		{
+			return m_conn;
+		}
+
+	private:
+		/// the executor the processor works for
+		AsyncExecutor	*m_executor;
+		/// the connection to run the jobs on
+		Connection		*m_conn;
+	};
+
+	/*!
+	@class AsyncExecutor epAsyncExecutor.h
+	@brief This is a class representing a pool of worker threads running queries
+
+	Interface for the executor, which runs query jobs on a set of connections,
+	with one worker thread per connection.
+	*Each job goes to the worker with the fewest queued jobs, whose queue is ordered by job priority
+	*/
+	class EP_ORACLELIB AsyncExecutor
+	{
+		// friends
+		friend class QueryJobProcessor;
+		friend class QueryJob;
+
+	public:
+		/*!
+		Default Constructor
+
+		Open the given number of connections and start a worker thread for each
+		@param[in] environment the environment to share
+		@param[in] serviceName the name of the service
+		@param[in] loginID the login ID for OracleDB
+		@param[in] password the password for given login ID
+		@param[in] workerCount the number of connections and worker threads
+		*/
+		AsyncExecutor (Environment &environment, const TCHAR *serviceName, const TCHAR *loginID, const TCHAR *password, unsigned int workerCount);
+
+		/*!
+		Default Constructor
+
+		Borrow the given number of sessions from the pool and start a worker thread for each
+		@param[in] pool the session pool to borrow from
+		@param[in] workerCount the number of sessions and worker threads
+		*/
+		AsyncExecutor (SessionPool &pool, unsigned int workerCount);
+
+		/*!
+		Default Destructor
+
+		Waits for the submitted jobs and closes the connections
+		*/
+		~AsyncExecutor ();
+
+		/*!
+		Queue given job
+		*The job is retained until it is done
+		@param[in] job the job to run
+		*/
+		void Submit (QueryJob &job);
+
+		/*!
+		Queue a job running given SQL statement without bind values
+		@param[in] sqlStmt the SQL statement to run
+		@param[in] priority the priority of the job in the queue of the worker
+		@param[in] callback the completion delegate (NULL for none, not owned)
+		@return the job queued (release it when done with it)
+		*/
+		QueryJob *Submit (const TCHAR *sqlStmt, epl::Priority priority = PRIORITY_NORMAL, QueryCallback *callback = NULL);
+
+		/*!
+		Wait for the submitted jobs
+		@param[in] waitTimeInMilliSec the time to wait in milli-seconds
+		@return true if every job is done, false if timed out
+		*/
+		bool WaitAll (unsigned int waitTimeInMilliSec = WAITTIME_INIFINITE);
+
+		/*!
+		Wait for the submitted jobs, stop the worker threads and close the connections
+		*/
+		void Stop ();
+
+		/*!
+		Return the number of submitted jobs not yet done
+		@return the number of pending jobs
+		*/
+		unsigned int GetPendingCount () const;
+
+		/*!
+		Return the number of worker threads
+		@return the number of worker threads
+		*/
+		inline unsigned int GetWorkerCount () const
+		{
+			return static_cast <unsigned int> (m_workers.size ());
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Class cannot be copied
+		@param executor the AsyncExecutor object to copy
+		*/
+		AsyncExecutor (const AsyncExecutor& executor)
+		{
+			/* could not be copy-constructed */
+		}
+
+		/*!
+		Copy Operator
+
+		*Class cannot be copied
+		@param executor the AsyncExecutor object to copy
+		*/
+		AsyncExecutor& operator = (const AsyncExecutor& executor)
+		{
+			return (*this); /* could not be copy-constructed */
+		}
+
+		/*!
+		Initialize the member variables
+		*/
+		void initialize ();
+
+		/*!
+		Start a worker thread running on given connection
+		@param[in] conn the connection of the worker (owned from now on)
+		*/
+		void addWorker (Connection *conn);
+
+		/*!
+		Release the job submitted and count it out of the pending jobs
+		*Called when the job is done by a processor, or dropped from the queue of a worker
+		@param[in] job the job done
+		*/
+		void jobDone (QueryJob *job);
+
+		/// the worker threads
+		std::vector <epl::WorkerThreadInfinite *>	m_workers;
+		/// the job processors of the worker threads
+		std::vector <QueryJobProcessor *>	m_processors;
+		/// the session pool the connections are borrowed from (NULL if opened by the executor)
+		SessionPool		*m_pool;
+
+		/// lock for the pending jobs
+		mutable epl::CriticalSectionEx	m_lock;
+		/// event raised when no job is pending
+		epl::EventEx	m_idleEvent;
+		/// the number of submitted jobs not yet done
+		unsigned int	m_pendingCount;
+		/// flag whether the executor is stopped
+		bool			m_isStopped;
+	};
+}
+
+#endif //__EP_ASYNC_EXECUTOR_H__
@@ -0,0 +1,260 @@
+/*! 
+@file epAsyncOperation.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Asynchronous Operation Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Asynchronous Operation.
+*/
+#ifndef __EP_ASYNC_OPERATION_H__
+#define __EP_ASYNC_OPERATION_H__
+
+#include "epOraLib.h"
+#include "epOraDefines.h"
+#include "oci.h"
+
+namespace epol
+{
+	class Statement;
+	class ResultSet;
+	class OraError;
+
+	/*!
+	@class AsyncOperation epAsyncOperation.h
+	@brief This is a class representing an OracleDB call in progress
+
+	Interface for the handle of an asynchronous call, driven to its completion by an AsyncReactor.
+	*Until the operation is done, the connection must not be used by any other call
+	*/
+	class EP_ORACLELIB AsyncOperation:public epl::SmartObject
+	{
+		// friends
+		friend class AsyncReactor;
+
+	public:
+		/*!
+		Return whether the operation is done
+		@return true if done (successfully or not), otherwise false.
+		*/
+		inline bool IsDone () const
+		{
+			return m_isDone;
+		}
+
+		/*!
+		Wait until the operation is done
+		*Throws the error of the operation, if it failed
+		@param[in] waitTimeInMilliSec the time to wait in milli-seconds
+		@return true if done, false if timed out
+		*/
+		bool Wait (unsigned int waitTimeInMilliSec = WAITTIME_INIFINITE);
+
+		/*!
+		Return the number of rows processed (execution) or fetched (fetch) by the operation
+		@return the number of rows of the operation
+		*/
+		inline unsigned int GetRowCount () const
+		{
+			return m_rowCount;
+		}
+
+	protected:
+		/*!
+		Default Constructor
+
+		Initializes the operation
+		*/
+		AsyncOperation ();
+
+		/*!
+		Default Destructor
+
+		Releases the error of the operation
+		*Use ReleaseObj instead
+		*/
+		virtual ~AsyncOperation ();
+
+		/*!
+		Issue the OCI call (again, while it returns OCI_STILL_EXECUTING)
+		@return the OCI result of the call
+		*/
+		virtual int step () = 0;
+
+		/*!
+		Complete the operation after the OCI call returned
+		*Throws the error of the call
+		@param[in] result the OCI result of the call
+		*/
+		virtual void complete (int result) = 0;
+
+		/*!
+		Mark the operation as done without any call
+		*/
+		void markDone ();
+
+		/// the number of rows of the operation
+		unsigned int	m_rowCount;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Class cannot be copied
+		@param operation the AsyncOperation object to copy
+		*/
+		AsyncOperation (const AsyncOperation& operation) :SmartObject(operation)
+		{
+			/* could not be copy-constructed */
+		}
+
+		/*!
+		Copy Operator
+
+		*Class cannot be copied
+		@param operation the AsyncOperation object to copy
+		*/
+		AsyncOperation& operator = (const AsyncOperation& operation)
+		{
+			return (*this); /* could not be copy-constructed */
+		}
+
+		/*!
+		Drive the operation once
+		*Called from the reactor thread
+		*/
+		void poll ();
+
+		/// event raised when the operation is done
+		epl::EventEx	m_doneEvent;
+		/// the error of the operation (NULL if succeeded)
+		OraError		*m_error;
+		/// flag whether the operation is done
+		volatile bool	m_isDone;
+	};
+
+	/*!
+	@class ExecuteOperation epAsyncOperation.h
+	@brief This is a class representing a Statement execution in progress
+
+	Interface for the asynchronous execution of a Statement (see Statement::ExecuteAsync).
+	*/
+	class EP_ORACLELIB ExecuteOperation:public AsyncOperation
+	{
+		// friends
+		friend class Statement;
+
+	protected:
+		/*!
+		Issue the execution
+		@return the OCI result of the call
+		*/
+		virtual int step ();
+
+		/*!
+		Complete the execution
+		@param[in] result the OCI result of the call
+		*/
+		virtual void complete (int result);
+
+		/*!
+		Default Destructor
+
+		Releases the statement
+		*/
+		virtual ~ExecuteOperation ();
+
+	private:
+		/*!
+		Default Constructor
+
+		*Cannot be created publicly
+		*Use Statement::ExecuteAsync
+		@param[in] stmt the statement to execute
+		@param[in] rowCount the number of rows to execute
+		@param[in] executeMode the execute mode
+		*/
+		ExecuteOperation (Statement *stmt, unsigned int rowCount, ExecuteModesEnum executeMode);
+
+		/// the statement executed
+		Statement		*m_stmt;
+		/// the number of iterations of the call
+		unsigned int	m_iters;
+		/// the OCI execute mode
+		unsigned int	m_mode;
+	};
+
+	/*!
+	@class FetchOperation epAsyncOperation.h
+	@brief This is a class representing a Result Set fetch in progress
+
+	Interface for the asynchronous fetch of the next block of rows (see ResultSet::FetchAsync).
+	*/
+	class EP_ORACLELIB FetchOperation:public AsyncOperation
+	{
+		// friends
+		friend class ResultSet;
+
+	protected:
+		/*!
+		Issue the fetch
+		@return the OCI result of the call
+		*/
+		virtual int step ();
+
+		/*!
+		Complete the fetch
+		@param[in] result the OCI result of the call
+		*/
+		virtual void complete (int result);
+
+		/*!
+		Default Destructor
+
+		Releases the result set
+		*/
+		virtual ~FetchOperation ();
+
+	private:
+		/*!
+		Default Constructor
+
+		*Cannot be created publicly
+		*Use ResultSet::FetchAsync
+		@param[in] resultSet the result set to fetch for
+		*/
+		FetchOperation (ResultSet *resultSet);
+
+		/// the result set fetched
+		ResultSet		*m_resultSet;
+	};
+}
+
+#endif //__EP_ASYNC_OPERATION_H__
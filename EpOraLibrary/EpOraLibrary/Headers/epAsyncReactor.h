@@ -0,0 +1,138 @@
+/*! 
+@file epAsyncReactor.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Asynchronous Reactor Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Asynchronous Reactor.
+*/
+#ifndef __EP_ASYNC_REACTOR_H__
+#define __EP_ASYNC_REACTOR_H__
+
+#include "epOraLib.h"
+#include "epOraDefines.h"
+#include <vector>
+
+namespace epol
+{
+	class AsyncOperation;
+
+	/*!
+	@class AsyncReactor epAsyncReactor.h
+	@brief This is a class representing the driver of asynchronous OracleDB calls
+
+	Interface for the reactor thread, which re-issues the calls of non-blocking connections
+	returning OCI_STILL_EXECUTING, until they complete.
+	*One reactor can keep many connections busy at once, each with one operation in progress
+	@remark a call on a blocking connection blocks the reactor thread until it completes
+	*/
+	class EP_ORACLELIB AsyncReactor: public epl::Thread
+	{
+		// friends
+		friend class Statement;
+		friend class ResultSet;
+
+	public:
+		/*!
+		Default Constructor
+
+		Starts the reactor thread
+		@param[in] pollInterval the time between two rounds over the pending operations in milli-seconds
+		*/
+		AsyncReactor (unsigned int pollInterval = ASYNC_REACTOR_POLL_INTERVAL);
+
+		/*!
+		Default Destructor
+
+		Stops the reactor thread
+		*/
+		virtual ~AsyncReactor ();
+
+		/*!
+		Drive the pending operations to their completion and stop the reactor thread
+		*/
+		void Stop ();
+
+		/*!
+		Return the number of operations submitted and not yet taken by the reactor thread
+		@return the number of operations waiting to be taken
+		*/
+		unsigned int GetQueuedCount () const;
+
+	protected:
+		/*!
+		Actual Thread Code.
+		*/
+		virtual void execute ();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Class cannot be copied
+		@param reactor the AsyncReactor object to copy
+		*/
+		AsyncReactor (const AsyncReactor& reactor)
+		{
+			/* could not be copy-constructed */ 
+		}
+
+		/*!
+		Copy Operator
+
+		*Class cannot be copied
+		@param reactor the AsyncReactor object to copy
+		*/
+		AsyncReactor& operator = (const AsyncReactor& reactor) 
+		{ 
+			return (*this); /* could not be copy-constructed */ 
+		}
+
+		/*!
+		Hand given operation to the reactor thread
+		@param[in] operation the operation to drive
+		*/
+		void submit (AsyncOperation *operation);
+
+		/// the operations submitted and not yet taken by the reactor thread
+		std::vector <AsyncOperation *>	m_submitted;
+		/// lock for the submitted operations
+		mutable epl::CriticalSectionEx	m_lock;
+		/// event raised when an operation is submitted or the reactor is stopping
+		epl::EventEx	m_wakeEvent;
+		/// the time between two rounds over the pending operations in milli-seconds
+		unsigned int	m_pollInterval;
+		/// flag whether the reactor thread is stopping
+		volatile bool	m_isStopping;
+	};
+}
+
+#endif //__EP_ASYNC_REACTOR_H__
@@ -39,6 +39,7 @@ An Interface for OracleDB Table Column.
 #include "epOraLib.h"
 #include <string>
 #include "epDateTime.h"
+#include "epColumnView.h"
 
 
 
@@ -66,6 +67,23 @@ namespace epol
 		*/
 		epl::EpTString ToString() const;
 
+		/*!
+		Returns the column data as a pointer into the fetch buffer without copying
+		*The text is NULL-terminated and stays valid until the result set moves to another block of rows
+		@param[out] retLength if not NULL, receives the length of the text in characters
+		@return the pointer to the column text
+		*/
+		const TCHAR *GetText (unsigned int *retLength = NULL) const;
+
+		/*!
+		Copies the column data to given buffer
+		*The text is truncated to fit and always NULL-terminated
+		@param[out] buffer the buffer to copy to
+		@param[in] capacity the size of the buffer in characters
+		@return the number of characters copied (excluding the terminator)
+		*/
+		unsigned int CopyTo (TCHAR *buffer, unsigned int capacity) const;
+
 		/*!
 		Returns the column data by converting it to double
 		@return column data in double format.
@@ -78,12 +96,44 @@ namespace epol
 		*/
 		long ToLong () const;
 
+		/*!
+		Returns the column data by converting it to 64-bit integer
+		@return column data in 64-bit integer format.
+		*/
+		__int64 ToInt64 () const;
+
+		/*!
+		Converts the rows of the current batch to 64-bit integers
+		*See ResultSet::NextBatch, NULL values are converted to 0
+		*Throws EC_BAD_FETCH_MODE if there is no current batch (Next ends the batch)
+		@param[out] retValues the array receiving GetBatchSize() values
+		@return the number of converted values
+		*/
+		unsigned int ToInt64Array (__int64 *retValues) const;
+
+		/*!
+		Converts the rows of the current batch to doubles
+		*See ResultSet::NextBatch, NULL values are converted to 0
+		*Throws EC_BAD_FETCH_MODE if there is no current batch (Next ends the batch)
+		@param[out] retValues the array receiving GetBatchSize() values
+		@return the number of converted values
+		*/
+		unsigned int ToDoubleArray (double *retValues) const;
+
 		/*!
 		Returns the column data by converting it to DateTime
 		@return column data in DateTime format.
 		*/
 		DateTime ToDateTime() const;
 
+		/*!
+		Returns the view over the rows of the current batch
+		*See ResultSet::NextBatch
+		*Throws EC_BAD_FETCH_MODE if there is no current batch (Next ends the batch)
+		@return the view over the rows of the current batch
+		*/
+		ColumnView GetView () const;
+
 
 	private:
 
@@ -96,9 +146,8 @@ namespace epol
 		@param[in] name the name of the column
 		@param[in] ociDataType the data type of this column
 		@param[in] maxDataSize the maximum data size of data type given
-		@param[in] fetchSize the size of fetching
 		*/
-		Column (ResultSet *rs, const TCHAR *name, unsigned short ociDataType, unsigned int maxDataSize, unsigned int fetchSize = FETCH_SIZE);
+		Column (ResultSet *rs, const TCHAR *name, unsigned short ociDataType, unsigned int maxDataSize, short precision, signed char scale);
 
 		/*!
 		Default Destructor
@@ -118,6 +167,35 @@ namespace epol
 		*/
 		void cleanUp ();
 
+		/*!
+		Return the number of bytes a single row of this column takes in the fetch buffers
+		@return the number of bytes per row including indicator and data length
+		*/
+		unsigned int getRowBytes () const;
+
+		/*!
+		Return the number of bytes the fetch buffers of this column take in the arena of the result set
+		@param[in] fetchSize the number of rows to request on each fetch
+		@param[in] bufferSets the number of buffer sets
+		@return the number of bytes, each array padded to a cache line
+		*/
+		size_t getArenaBytes (unsigned int fetchSize, unsigned int bufferSets) const;
+
+		/*!
+		Lay out the fetch buffers for given number of rows in the arena of the result set
+		*The arena is owned by the result set, the column does not free it
+		@param[in] fetchSize the number of rows to request on each fetch
+		@param[in] bufferSets the number of buffer sets to lay out
+		@param[in] arena the cache line aligned memory of getArenaBytes bytes to use
+		*/
+		void allocate (unsigned int fetchSize, unsigned int bufferSets, char *arena);
+
+		/*!
+		Make given buffer set the one the accessors read from
+		@param[in] bufferSet the buffer set to read from
+		*/
+		void selectBufferSet (unsigned int bufferSet);
+
 		/*!
 		Default Copy Constructor
 
@@ -157,6 +235,15 @@ namespace epol
 		/// the buffer which holds the data (fetched)
 		char* m_fetchBuffer;	
 
+		/// arrays with indicators for each buffer set (in the arena of the result set)
+		short* m_indicatorSets[FETCH_BUFFER_SETS];
+		/// arrays with data lengths for each buffer set
+		unsigned short* m_dataLengthSets[FETCH_BUFFER_SETS];
+		/// fetch buffers for each buffer set (in the arena of the result set)
+		char* m_fetchBufferSets[FETCH_BUFFER_SETS];
+		/// the number of buffer sets allocated
+		unsigned int m_bufferSets;
+
 		/// handle for column
 		OCIDefine* m_defineHandle;
 		/// the owner result set of this column
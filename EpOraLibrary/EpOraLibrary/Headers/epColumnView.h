@@ -0,0 +1,177 @@
+/*! 
+@file epColumnView.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Column View Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Column View.
+*/
+#ifndef __EP_COLUMN_VIEW_H__
+#define __EP_COLUMN_VIEW_H__
+
+#include "epOraLib.h"
+#include "epOraDefines.h"
+
+namespace epol
+{
+	/*! 
+	@class ColumnView epColumnView.h
+	@brief This is a class representing a view over the fetched rows of a column
+
+	Interface for the view over a batch of fetched rows of a column.
+	*The view points directly into the fetch buffers of the column, so nothing is copied
+	*The view is valid until the result set moves past the batch (ResultSet::Next or ResultSet::NextBatch)
+	*/
+	class EP_ORACLELIB ColumnView
+	{
+		friend class Column;
+	public:
+		/*!
+		Default Constructor
+
+		Create an empty view
+		*/
+		inline ColumnView ()
+		{
+			m_colType = DT_UNKNOWN;
+			m_ociType = 0;
+			m_data = NULL;
+			m_stride = 0;
+			m_indicators = NULL;
+			m_dataLengths = NULL;
+			m_rowCount = 0;
+		}
+
+		/*!
+		Return the number of rows in the view
+		@return the number of rows in the view
+		*/
+		inline unsigned int GetRowCount () const
+		{
+			return m_rowCount;
+		}
+
+		/*!
+		Return the type of the column
+		@return the type of the column
+		*/
+		inline DataTypesEnum GetType () const
+		{
+			return m_colType;
+		}
+
+		/*!
+		Return the Oracle's data type the rows are stored in
+		*(SQLT_INT, SQLT_BDOUBLE or SQLT_VNU for numbers, SQLT_ODT for dates, SQLT_STR for text)
+		@return the Oracle's data type the rows are stored in
+		*/
+		inline unsigned short GetOciType () const
+		{
+			return m_ociType;
+		}
+
+		/*!
+		Return the pointer to the data of the first row
+		@return the pointer to the data of the first row
+		*/
+		inline const char *GetData () const
+		{
+			return m_data;
+		}
+
+		/*!
+		Return the number of bytes between the data of two consecutive rows
+		@return the number of bytes between the data of two consecutive rows
+		*/
+		inline unsigned int GetStride () const
+		{
+			return m_stride;
+		}
+
+		/*!
+		Return the indicator array (ORADATA_NULL for NULL values)
+		@return the indicator array
+		*/
+		inline const short *GetIndicators () const
+		{
+			return m_indicators;
+		}
+
+		/*!
+		Return the data length array (text columns only, otherwise NULL)
+		@return the data length array in bytes
+		*/
+		inline const unsigned short *GetDataLengths () const
+		{
+			return m_dataLengths;
+		}
+
+		/*!
+		Return whether the value at given row is NULL
+		@param[in] row the row within the view
+		@return true if the value is NULL otherwise false
+		*/
+		inline bool IsNull (unsigned int row) const
+		{
+			EP_ASSERT (row < m_rowCount);
+			return (m_indicators[row] == ORADATA_NULL);
+		}
+
+		/*!
+		Return the pointer to the data at given row
+		@param[in] row the row within the view
+		@return the pointer to the data at given row
+		*/
+		inline const char *GetData (unsigned int row) const
+		{
+			EP_ASSERT (row < m_rowCount);
+			return (m_data + m_stride * row);
+		}
+
+	private:
+		/// the type of the column
+		DataTypesEnum m_colType;
+		/// the Oracle's data type the rows are stored in
+		unsigned short m_ociType;
+		/// the data of the first row
+		const char *m_data;
+		/// the number of bytes between two rows
+		unsigned int m_stride;
+		/// array with indicators
+		const short *m_indicators;
+		/// array with data lengths (for text columns)
+		const unsigned short *m_dataLengths;
+		/// the number of rows in the view
+		unsigned int m_rowCount;
+	};
+}
+
+#endif //__EP_COLUMN_VIEW_H__
@@ -38,7 +38,13 @@ An Interface for OracleDB Connection.
 #define	__EP_CONNECTION_H__
 
 #include "epOraLib.h"
+#include "epOraDefines.h"
+#include "epEnvironment.h"
+#include "epSessionPool.h"
+#include "epOraError.h"
 #include "oci.h"
+#include <list>
+#include <map>
 namespace epol 
 {
 	class Statement;
@@ -49,6 +55,11 @@ namespace epol
 	@brief This is a class representing OracleDB Connection
 
 	Interface for the OracleDB Connection class.
+	*Thread model: with an OCI_THREADED environment, one connection may be shared by many threads.
+	*Each Statement, ResultSet and DirectPathLoader reports into its own error handle, and OCI serializes
+	*the round trips of the session, so calls from different threads never mix their errors.
+	*A single Statement (with its parameters) or ResultSet must be used by one thread at a time.
+	*For parallel work on the server, use one connection (session) per thread, e.g. from a SessionPool.
 	*/
 	class EP_ORACLELIB Connection
 	{
@@ -57,6 +68,8 @@ namespace epol
 		friend class Parameter;
 		friend class ResultSet;
 		friend class Column;
+		friend class FetchWorker;
+		friend class DirectPathLoader;
 
 
 	public:
@@ -79,6 +92,26 @@ namespace epol
 		*/
 		Connection (const TCHAR *serviceName, const TCHAR *loginID,const TCHAR *password, unsigned long envMode = OCI_THREADED|OCI_OBJECT, bool nonBlockingMode = false);
 
+		/*!
+		Default Constructor
+
+		Create an instance of connection and open the connection to OracleDB within given environment
+		@param[in] environment the environment to share
+		@param[in] serviceName the name of the service
+		@param[in] loginID the login ID for OracleDB
+		@param[in] password the password for given login ID
+		@param[in] nonBlockingMode the flag for whether OracleDB Operation is blocking or not
+		*/
+		Connection (Environment &environment, const TCHAR *serviceName, const TCHAR *loginID,const TCHAR *password, bool nonBlockingMode = false);
+
+		/*!
+		Default Constructor
+
+		Create an instance of connection on a session borrowed from given pool
+		@param[in] pool the session pool to borrow from
+		*/
+		Connection (SessionPool &pool);
+
 		~Connection ();
 
 		/*!
@@ -91,6 +124,25 @@ namespace epol
 		*/
 		void Open (const TCHAR *serviceName,const TCHAR *loginID,const TCHAR *password,unsigned long envMode = OCI_THREADED|OCI_OBJECT, bool nonBlockingMode = false);
 
+		/*!
+		Connects to the OracleDB with given information within given environment
+		*The environment is retained until the connection is closed
+		@param[in] environment the environment to share
+		@param[in] serviceName the name of the service
+		@param[in] loginID the login ID for OracleDB
+		@param[in] password the password for given login ID
+		@param[in] nonBlockingMode the flag for whether OracleDB Operation is blocking or not
+		*/
+		void Open (Environment &environment, const TCHAR *serviceName,const TCHAR *loginID,const TCHAR *password, bool nonBlockingMode = false);
+
+		/*!
+		Borrows a session from given pool
+		*The pool is retained and the session given back to it when the connection is closed
+		*Throws EC_POOL_NOT_SETUP if the pool is not created, EC_TIMEOUT if no session is free within the pool's get timeout
+		@param[in] pool the session pool to borrow from
+		*/
+		void Open (SessionPool &pool);
+
 		/*!
 		Close the connection
 		*/
@@ -102,8 +154,18 @@ namespace epol
 		*/
 		void Execute (const TCHAR *sqlStmt);
 
+		/*!
+		Execute the given SQL statement, returning the error of the call instead of throwing it
+		*For hot paths where errors are expected (a duplicate key, a lock timeout), the error text is not taken
+		@param[in] sqlStmt the SQL statement to execute.
+		@return the status of the execution
+		*/
+		Status TryExecute (const TCHAR *sqlStmt);
+
 		/*!
 		Prepare the SQL statement given for execution, and return the statement instance.
+		*A statement with the same SQL text which is not in use is taken from the statement cache,
+		*together with its bound parameters
 		@param[in] sqlStmt the SQL statement to prepare.
 		@return the statement instance with given SQL statement.
 		*/
@@ -112,25 +174,34 @@ namespace epol
 		/*!
 		Execute the SQL statement given, and return the result set.
 		@param[in] selectStmt the SQL statement to execute.
+		@param[in] fetchSize the number of rows to request on each fetch (0 to derive it from the fetch memory budget)
+		@param[in] fetchMode the fetch mode (FM_PIPELINED requires the environment to be created with OCI_THREADED,
+		*FM_BOUND_ROWS fetches nothing until rows are bound with ResultSet::BindRows)
 		@return the result set which resulted by executing given SQL statement.
 		*/
-		ResultSet *Select (const TCHAR *selectStmt);
+		ResultSet *Select (const TCHAR *selectStmt, unsigned int fetchSize = 0, FetchModesEnum fetchMode = FM_DEFAULT);
 
 		/*!
 		Commit the changes made.
 		*/
-		inline void Commit ()
-		{ 
-			Execute (_T("commit")); 
-		}
+		void Commit ();
 
 		/*!
 		Roll back the changes made.
 		*/
-		inline void Rollback ()
-		{ 
-			Execute (_T("rollback")); 
-		}
+		void Rollback ();
+
+		/*!
+		Commit the changes made, returning the error of the call instead of throwing it
+		@return the status of the commit
+		*/
+		Status TryCommit ();
+
+		/*!
+		Roll back the changes made, returning the error of the call instead of throwing it
+		@return the status of the rollback
+		*/
+		Status TryRollback ();
 
 		/*!
 		Return whether connected to OracleDB
@@ -150,6 +221,58 @@ namespace epol
 			return m_isBlocking;
 		}
 
+		/*!
+		Set the maximal number of prepared statements kept for reuse by Prepare, Execute and Select
+		*The least recently used statements are released first
+		@param[in] size the number of statements to keep (0 to disable the cache)
+		*/
+		void SetStatementCacheSize(unsigned int size);
+
+		/*!
+		Return the maximal number of prepared statements kept for reuse
+		@return the size of the statement cache
+		*/
+		inline unsigned int GetStatementCacheSize()
+		{
+			return m_statementCacheSize;
+		}
+
+		/*!
+		Set the maximal number of fetch buffer arenas kept for reuse by the next result sets of the same shape
+		*The idle arenas never hold more than FETCH_BUFFER_POOL_MAX_BYTES bytes all together
+		@param[in] size the number of arenas to keep (0 to disable the pool)
+		*/
+		void SetFetchBufferPoolSize(unsigned int size);
+
+		/*!
+		Return the maximal number of fetch buffer arenas kept for reuse
+		@return the size of the fetch buffer pool
+		*/
+		inline unsigned int GetFetchBufferPoolSize()
+		{
+			return m_arenaPoolSize;
+		}
+
+		/*!
+		Set the number of bytes each result set of this connection may spend on its fetch buffers
+		*The number of rows to request on each fetch is derived from this budget and the described row width
+		@param[in] budget the fetch memory budget in bytes
+		*/
+		inline void SetFetchMemoryBudget(unsigned int budget)
+		{
+			EP_ASSERT (budget > 0);
+			m_fetchMemoryBudget = budget;
+		}
+
+		/*!
+		Return the number of bytes each result set of this connection may spend on its fetch buffers
+		@return the fetch memory budget in bytes
+		*/
+		inline unsigned int GetFetchMemoryBudget()
+		{
+			return m_fetchMemoryBudget;
+		}
+
 	private:
 		/*!
 		Default Copy Constructor
@@ -186,7 +309,79 @@ namespace epol
 			Close (); 
 		};
 
-		/// environment handle
+		/*!
+		Commit or roll back the transaction without throwing the error of the call
+		*The connection lock must be held, as the error is in the connection's own error handle
+		@param[in] isCommit true to commit, false to roll back
+		@return the OCI result of the call
+		*/
+		int endTransaction (bool isCommit);
+
+		/*!
+		Return the cached statement prepared with given SQL text, if it is not in use
+		@param[in] sqlStmt the SQL statement to look for
+		@return the retained statement, or NULL if there is none not in use
+		*/
+		Statement *findCachedStatement (const TCHAR *sqlStmt);
+
+		/*!
+		Keep given statement for reuse, releasing the least recently used ones over the cache size
+		@param[in] statement the statement to keep
+		*/
+		void cacheStatement (Statement *statement);
+
+		/*!
+		Release the cached statements over given number
+		@param[in] size the number of statements to keep
+		*/
+		void trimStatementCache (unsigned int size);
+
+		/*!
+		Take an idle fetch buffer arena of given size out of the pool
+		@param[in] bytes the size of the arena in bytes
+		@return the arena, or NULL if there is none of that size
+		*/
+		char *borrowArena (size_t bytes);
+
+		/*!
+		Keep given fetch buffer arena for reuse, or free it if the pool is full
+		@param[in] arena the arena to return
+		@param[in] bytes the size of the arena in bytes
+		*/
+		void returnArena (char *arena, size_t bytes);
+
+		/*!
+		Free the idle fetch buffer arenas over given number
+		@param[in] size the number of arenas to keep
+		*/
+		void trimArenaPool (unsigned int size);
+
+		/// Type definition for the cached statements (the most recently used first)
+		typedef std::list <Statement *> StatementList;
+		/// Type definition for the cached statements against their SQL text
+		typedef std::map <epl::EpTString, StatementList::iterator> StatementCache;
+		/// the cached statements
+		StatementList	m_cachedStatements;
+		/// the cached statements against their SQL text
+		StatementCache	m_statementCache;
+		/// the maximal number of cached statements
+		unsigned int	m_statementCacheSize;
+		/// Type definition for the idle fetch buffer arenas against their size
+		typedef std::multimap <size_t, char *> ArenaPool;
+		/// the idle fetch buffer arenas
+		ArenaPool		m_arenaPool;
+		/// the number of bytes held by the idle fetch buffer arenas
+		size_t			m_arenaPoolBytes;
+		/// the maximal number of idle fetch buffer arenas
+		unsigned int	m_arenaPoolSize;
+		/// lock for the statement cache, the fetch buffer pool and the connection's own error handle
+		epl::CriticalSectionEx	m_lock;
+
+		/// the environment used
+		Environment	*m_environment;
+		/// the session pool the session is borrowed from (NULL if not pooled)
+		SessionPool	*m_pool;
+		/// environment handle (owned by m_environment)
 		OCIEnv		*m_envHandle;
 		/// server handle
 		OCIServer	*m_serverHandle;
@@ -202,6 +397,9 @@ namespace epol
 		/// flag whether the mode is blocking or not
 		bool		m_isBlocking;
 
+		/// the number of bytes each result set may spend on its fetch buffers
+		unsigned int	m_fetchMemoryBudget;
+
 	};
 
 
@@ -0,0 +1,233 @@
+/*! 
+@file epDirectPathLoader.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Direct Path Loader Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Direct Path Loader.
+*/
+#ifndef __EP_DIRECT_PATH_LOADER_H__
+#define __EP_DIRECT_PATH_LOADER_H__
+
+#include "epOraLib.h"
+#include "epOraDefines.h"
+#include <vector>
+#include "oci.h"
+
+namespace epol
+{
+	class Connection;
+
+	/// Structure describing the values of one column within a batch given to DirectPathLoader::LoadBatch
+	struct DirectPathColumnData
+	{
+		/// the value of the first row
+		const void *m_data;
+		/// the number of bytes between the values of two consecutive rows
+		unsigned int m_stride;
+		/// array with the length of each value in bytes (NULL to use m_length for every row)
+		const unsigned int *m_lengths;
+		/// the length of every value in bytes when m_lengths is NULL
+		unsigned int m_length;
+		/// array with indicators (ORADATA_NULL for NULL values, NULL if no value is NULL)
+		const short *m_indicators;
+	};
+
+	/*! 
+	@class DirectPathLoader epDirectPathLoader.h
+	@brief This is a class representing OracleDB Direct Path Load
+
+	Interface for loading rows into a table through the direct path API, bypassing SQL processing.
+	*Usage: AddColumn for each loaded column, Prepare, LoadBatch as many times as needed, then Finish (or Abort)
+	@remark the table is locked until the load is finished or aborted
+	*/
+	class EP_ORACLELIB DirectPathLoader
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Create a loader for given table
+		@param[in] useConnection the connection to load through
+		@param[in] tableName the name of the table to load
+		@param[in] schemaName the schema of the table (NULL for the connected user's schema)
+		@param[in] streamBufferSize the size of the stream buffer in bytes
+		*/
+		DirectPathLoader (Connection &useConnection, const TCHAR *tableName, const TCHAR *schemaName = NULL, unsigned int streamBufferSize = DIRPATH_STREAM_BUFFER_SIZE);
+
+		/*!
+		Default Destructor
+
+		Aborts the load if it is not finished
+		*/
+		~DirectPathLoader ();
+
+		/*!
+		Add a column to load, in the order the batch columns are given
+		@param[in] columnName the name of the column
+		@param[in] maxDataSize the maximal length of a value in bytes
+		@param[in] ociType the Oracle's data type of the supplied values (SQLT_CHR for text)
+		@param[in] dateFormat the format of text date values (NULL for the session default)
+		*/
+		void AddColumn (const TCHAR *columnName, unsigned int maxDataSize, unsigned short ociType = SQLT_CHR, const TCHAR *dateFormat = NULL);
+
+		/*!
+		Describe the table and prepare the load
+		*/
+		void Prepare ();
+
+		/*!
+		Load a batch of rows given column by column
+		*The rows are converted and sent in chunks of GetColumnArrayRows rows
+		@param[in] columns the values of each added column, in the order of AddColumn
+		@param[in] rowCount the number of rows in the batch
+		*/
+		void LoadBatch (const DirectPathColumnData *columns, unsigned int rowCount);
+
+		/*!
+		Finish the load, committing the loaded rows
+		*If the finish fails, the load is aborted and the error of the finish is thrown
+		*/
+		void Finish ();
+
+		/*!
+		Abort the load, discarding the loaded rows
+		*/
+		void Abort ();
+
+		/*!
+		Return the number of rows converted at once
+		@return the number of rows of the column array
+		*/
+		inline unsigned int GetColumnArrayRows () const
+		{
+			return m_columnArrayRows;
+		}
+
+		/*!
+		Return the number of rows loaded so far
+		@return the number of rows loaded so far
+		*/
+		inline unsigned __int64 GetRowsLoaded () const
+		{
+			return m_rowsLoaded;
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Class cannot be copied
+		@param loader the DirectPathLoader object to copy
+		*/
+		DirectPathLoader (const DirectPathLoader& loader)
+		{
+			/* could not be copy-constructed */ 
+		}
+
+		/*!
+		Copy Operator
+
+		*Class cannot be copied
+		@param loader the DirectPathLoader object to copy
+		*/
+		DirectPathLoader& operator = (const DirectPathLoader& loader) 
+		{ 
+			return (*this); /* could not be copy-constructed */ 
+		}
+
+		/*!
+		Initialize member variables
+		*/
+		void initialize ();
+
+		/*!
+		Release all resources allocated
+		*/
+		void cleanUp ();
+
+		/*!
+		Describe the added columns to the direct path context
+		*/
+		void describeColumns ();
+
+		/*!
+		Convert the rows set in the column array and load them
+		@param[in] rowCount the number of rows set in the column array
+		*/
+		void convertAndLoad (unsigned int rowCount);
+
+		/// Structure for an added column
+		struct LoadColumn
+		{
+			/// the name of the column
+			epl::EpTString m_name;
+			/// the maximal length of a value in bytes
+			unsigned int m_maxDataSize;
+			/// the Oracle's data type of the values
+			unsigned short m_ociType;
+			/// the format of text date values (empty for default)
+			epl::EpTString m_dateFormat;
+		};
+
+		/// Type Definition for LoadColumns
+		typedef std::vector <LoadColumn> LoadColumns;
+		/// the added columns
+		LoadColumns		m_columns;
+
+		/// the connection used
+		Connection		*m_conn;
+		/// the name of the table
+		epl::EpTString	m_tableName;
+		/// the schema of the table
+		epl::EpTString	m_schemaName;
+		/// the size of the stream buffer in bytes
+		unsigned int	m_streamBufferSize;
+
+		/// error handle of the load
+		OCIError			*m_errorHandle;
+		/// direct path context handle
+		OCIDirPathCtx		*m_ctxHandle;
+		/// direct path column array handle
+		OCIDirPathColArray	*m_columnArrayHandle;
+		/// direct path stream handle
+		OCIDirPathStream	*m_streamHandle;
+
+		/// the number of rows of the column array
+		unsigned int	m_columnArrayRows;
+		/// the number of rows loaded so far
+		unsigned __int64	m_rowsLoaded;
+		/// flag whether the load is prepared and not finished yet
+		bool			m_isPrepared;
+	};
+}
+
+#endif //__EP_DIRECT_PATH_LOADER_H__
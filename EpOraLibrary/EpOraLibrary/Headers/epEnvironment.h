@@ -0,0 +1,137 @@
+/*! 
+@file epEnvironment.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Environment Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Environment.
+*/
+#ifndef __EP_ENVIRONMENT_H__
+#define __EP_ENVIRONMENT_H__
+
+#include "epOraLib.h"
+#include "oci.h"
+
+namespace epol
+{
+	/// Structure for the memory callbacks of an OCI environment
+	struct MemoryCallbacks
+	{
+		/// the context passed to the callbacks
+		void *m_context;
+		/// the allocation callback
+		void *(*m_malloc) (void *context, size_t size);
+		/// the reallocation callback
+		void *(*m_realloc) (void *context, void *memory, size_t newSize);
+		/// the release callback
+		void (*m_free) (void *context, void *memory);
+	};
+
+	/*! 
+	@class Environment epEnvironment.h
+	@brief This is a class representing OracleDB Environment
+
+	Interface for the OCI environment, which can be shared by many connections (and pools).
+	*The environment is reference counted: each connection using it retains it,
+	*so the creator may release it once all connections are opened
+	@remark connections used from different threads require OCI_THREADED mode
+	*/
+	class EP_ORACLELIB Environment:public epl::SmartObject
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Create the OCI environment
+		@param[in] envMode the Oracle Environment Mode
+		@param[in] charsetId the character set (0 for NLS_LANG; UNICODE builds always use OCI_UTF16ID)
+		@param[in] callbacks the memory callbacks (NULL for OCI's own allocator)
+		*/
+		Environment (unsigned long envMode = OCI_THREADED|OCI_OBJECT, unsigned short charsetId = 0, const MemoryCallbacks *callbacks = NULL);
+
+		/*!
+		Return the OCI environment handle
+		@return the OCI environment handle
+		*/
+		inline OCIEnv *GetHandle () const
+		{
+			return m_envHandle;
+		}
+
+		/*!
+		Return the Oracle Environment Mode
+		@return the Oracle Environment Mode
+		*/
+		inline unsigned long GetMode () const
+		{
+			return m_envMode;
+		}
+
+	protected:
+		/*!
+		Default Destructor
+
+		Frees the OCI environment
+		*Use ReleaseObj instead
+		*/
+		virtual ~Environment ();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Class cannot be copied
+		@param env the Environment object to copy
+		*/
+		Environment (const Environment& env) :SmartObject(env)
+		{
+			/* could not be copy-constructed */ 
+		}
+
+		/*!
+		Copy Operator
+
+		*Class cannot be copied
+		@param env the Environment object to copy
+		*/
+		Environment& operator = (const Environment& env) 
+		{ 
+			return (*this); /* could not be copy-constructed */ 
+		}
+
+		/// environment handle
+		OCIEnv			*m_envHandle;
+		/// the Oracle Environment Mode
+		unsigned long	m_envMode;
+	};
+}
+
+#endif //__EP_ENVIRONMENT_H__
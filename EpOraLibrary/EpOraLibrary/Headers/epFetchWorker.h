@@ -0,0 +1,159 @@
+/*! 
+@file epFetchWorker.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Result Set Background Fetcher Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Result Set Background Fetcher.
+*/
+#ifndef __EP_FETCH_WORKER_H__
+#define __EP_FETCH_WORKER_H__
+
+#include "epOraLib.h"
+#include "oci.h"
+
+namespace epol
+{
+	class ResultSet;
+
+	/*! 
+	@class FetchWorker epFetchWorker.h
+	@brief This is a class representing the background fetcher of a pipelined Result Set
+
+	Interface for the background fetcher, which fills the back buffer set of a Result Set
+	while the caller walks the front buffer set.
+	*/
+	class EP_ORACLELIB FetchWorker: public epl::Thread
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Allocates own error handle and starts the worker thread
+		@param[in] rs the result set to fetch for
+		*/
+		FetchWorker (ResultSet *rs);
+
+		/*!
+		Default Destructor
+
+		Stops the worker thread and releases the error handle
+		*/
+		virtual ~FetchWorker ();
+
+		/*!
+		Request the next array of rows to be fetched into given buffer set
+		@param[in] bufferSet the buffer set to fill
+		*/
+		void Request (unsigned int bufferSet);
+
+		/*!
+		Wait until the requested array of rows is fetched
+		*With no request pending, returns the result of the last fetch at once
+		*(a failed fetch is not requested again, so its error stays in the error handle)
+		@return the OCI result of the fetch
+		*/
+		int Wait ();
+
+		/*!
+		Wait for the pending request and stop the worker thread
+		*/
+		void Stop ();
+
+		/*!
+		Return the number of rows fetched by the last request
+		@return the number of rows fetched by the last request
+		*/
+		inline unsigned int GetRowsFetched () const
+		{
+			return m_rowsFetched;
+		}
+
+		/*!
+		Return the error handle used by the worker thread
+		@return the error handle used by the worker thread
+		*/
+		inline OCIError *GetErrorHandle () const
+		{
+			return m_errorHandle;
+		}
+
+	protected:
+		/*!
+		Actual Thread Code.
+		*/
+		virtual void execute ();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Class cannot be copied
+		@param worker the FetchWorker object to copy
+		*/
+		FetchWorker (const FetchWorker& worker)
+		{
+			/* could not be copy-constructed */ 
+		}
+
+		/*!
+		Copy Operator
+
+		*Class cannot be copied
+		@param worker the FetchWorker object to copy
+		*/
+		FetchWorker& operator = (const FetchWorker& worker) 
+		{ 
+			return (*this); /* could not be copy-constructed */ 
+		}
+
+		/// the result set to fetch for
+		ResultSet *m_resultSet;
+		/// error handle owned by the worker thread
+		OCIError *m_errorHandle;
+		/// event raised when a request is made
+		epl::EventEx m_requestEvent;
+		/// event raised when a request is done
+		epl::EventEx m_doneEvent;
+		/// the buffer set to fill
+		unsigned int m_bufferSet;
+		/// the OCI result of the last request
+		int m_result;
+		/// the number of rows fetched by the last request
+		unsigned int m_rowsFetched;
+		/// flag whether a request is pending
+		bool m_isPending;
+		/// flag whether the worker thread is stopping
+		volatile bool m_isStopping;
+	};
+}
+
+#endif //__EP_FETCH_WORKER_H__
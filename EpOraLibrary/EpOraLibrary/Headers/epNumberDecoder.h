@@ -0,0 +1,111 @@
+/*! 
+@file epNumberDecoder.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Number Decoder Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Number Decoder.
+*/
+#ifndef __EP_NUMBER_DECODER_H__
+#define __EP_NUMBER_DECODER_H__
+
+#include "epOraLib.h"
+#include "oci.h"
+
+namespace epol
+{
+	/*! 
+	@class NumberDecoder epNumberDecoder.h
+	@brief This is a class for decoding Oracle NUMBER values
+
+	Interface for decoding OCINumber (VARNUM) values without calling into OCI.
+	*Values which cannot be decoded exactly are left to OCINumberToInt/OCINumberToReal
+	*/
+	class EP_ORACLELIB NumberDecoder
+	{
+	public:
+		/*!
+		Decode given number to 64-bit integer
+		*Succeeds only for integral values below 10^18 in magnitude
+		@param[in] number the number to decode
+		@param[out] retValue the decoded value
+		@return true if decoded, false if the value must be converted by OCI
+		*/
+		static bool ToInt64 (const OCINumber *number, __int64 &retValue);
+
+		/*!
+		Decode given number to double
+		*Succeeds only when the result is exact (mantissa up to 2^53 and power of ten within 10^22)
+		@param[in] number the number to decode
+		@param[out] retValue the decoded value
+		@return true if decoded, false if the value must be converted by OCI
+		*/
+		static bool ToDouble (const OCINumber *number, double &retValue);
+
+		/*!
+		Convert an array of numbers to 64-bit integers
+		*NULL values are converted to 0
+		@param[in] errorHandle the error handle used for the OCI fallback
+		@param[in] numbers the array of numbers
+		@param[in] indicators the array of indicators (may be NULL)
+		@param[in] count the number of values
+		@param[out] retValues the array receiving the converted values
+		*/
+		static void ToInt64Array (OCIError *errorHandle, const OCINumber *numbers, const short *indicators, unsigned int count, __int64 *retValues);
+
+		/*!
+		Convert an array of numbers to doubles
+		*NULL values are converted to 0
+		@param[in] errorHandle the error handle used for the OCI fallback
+		@param[in] numbers the array of numbers
+		@param[in] indicators the array of indicators (may be NULL)
+		@param[in] count the number of values
+		@param[out] retValues the array receiving the converted values
+		*/
+		static void ToDoubleArray (OCIError *errorHandle, const OCINumber *numbers, const short *indicators, unsigned int count, double *retValues);
+
+	private:
+		/*!
+		Split given number into sign, base-100 mantissa and base-100 exponent
+		*value = (retIsNegative ? -1 : 1) * retMantissa * 100^retExponent
+		@param[in] number the number to decode
+		@param[out] retIsNegative the sign of the number
+		@param[out] retMantissa the mantissa
+		@param[out] retExponent the exponent
+		@return false if the number is infinite, malformed or its mantissa does not fit
+		*/
+		static bool decode (const OCINumber *number, bool &retIsNegative, __int64 &retMantissa, int &retExponent);
+
+		NumberDecoder ();
+	};
+}
+
+#endif //__EP_NUMBER_DECODER_H__
@@ -84,9 +84,50 @@ namespace epol
 		/// Text type
 		DT_TEXT,
 		/// ResultSet type
-		DT_RESULT_SET
+		DT_RESULT_SET,
+		/// Native 32-bit integer type (bound as SQLT_INT, no prefix)
+		DT_INT32,
+		/// Native 64-bit integer type (bound as SQLT_INT, no prefix)
+		DT_INT64,
+		/// Native unsigned 64-bit integer type (bound as SQLT_UIN, no prefix)
+		DT_UINT64,
+		/// Native double type (bound as SQLT_BDOUBLE, no prefix)
+		DT_DOUBLE
 	};
 
+	/// Enumerator for Result Set fetch modes
+	enum FetchModesEnum
+	{
+		/// Fetch each array of rows when the previous one is consumed
+		FM_DEFAULT,
+		/// Fetch the next array of rows in background while the current one is consumed
+		FM_PIPELINED,
+		/// Fetch rows directly into caller's row structures (see ResultSet::BindRows)
+		FM_BOUND_ROWS
+	};
+
+	/// Enumerator for Statement execute modes, combined as flags (Ex: EM_BATCH_ERRORS|EM_COMMIT_ON_SUCCESS)
+	enum ExecuteModesEnum
+	{
+		/// Stop at the first failing row
+		EM_DEFAULT = 0x0,
+		/// Execute every row of an array DML and collect the failing rows (see Statement::GetBatchErrors)
+		EM_BATCH_ERRORS = 0x1,
+		/// Commit the transaction in the same round trip when the execution succeeds
+		EM_COMMIT_ON_SUCCESS = 0x2
+	};
+
+	/*!
+	Combine the given execute modes
+	@param[in] left the first modes
+	@param[in] right the second modes
+	@return both modes
+	*/
+	inline ExecuteModesEnum operator | (ExecuteModesEnum left, ExecuteModesEnum right)
+	{
+		return static_cast <ExecuteModesEnum> (static_cast <unsigned int> (left) | static_cast <unsigned int> (right));
+	}
+
 	/// Enumberator for Parameter prefixes
 	//* (Ex: :n1 is a number, :sName is a text)
 	enum ParameterPrefixesEnum
@@ -113,12 +154,118 @@ namespace epol
 
 	/*!
 	@def FETCH_SIZE
-	@brief number of rows to request on each fetch
+	@brief maximal number of rows to request on each fetch
 
-	Macro for the number of rows to request on each fetch.
+	Macro for the maximal number of rows to request on each fetch, when the number of rows is derived from the fetch memory budget.
 	*/
 	#define FETCH_SIZE 200000
 
+	/*!
+	@def FETCH_MEMORY_BUDGET
+	@brief default number of bytes a result set may spend on its fetch buffers
+
+	Macro for the default number of bytes a result set may spend on its fetch buffers.
+	The number of rows to request on each fetch is derived from this budget and the described row width.
+	*/
+	#define FETCH_MEMORY_BUDGET (16*1024*1024)
+
+	/*!
+	@def FETCH_BUFFER_SETS
+	@brief maximal number of fetch buffer sets per column
+
+	Macro for the maximal number of fetch buffer sets per column (pipelined fetching uses two)
+	*/
+	#define FETCH_BUFFER_SETS 2
+
+	/*!
+	@def CACHE_LINE_SIZE
+	@brief size of a cache line in bytes
+
+	Macro for the size of a cache line, the alignment of each array laid out in a result set's buffer arena.
+	*/
+	#define CACHE_LINE_SIZE 64
+
+	/*!
+	@def ALIGN_TO_CACHE_LINE
+	@brief round given number of bytes up to a multiple of the cache line size
+
+	Macro for rounding given number of bytes up to a multiple of CACHE_LINE_SIZE.
+	*/
+	#define ALIGN_TO_CACHE_LINE(bytes) (((bytes) + CACHE_LINE_SIZE - 1) & ~((size_t) CACHE_LINE_SIZE - 1))
+
+	/*!
+	@def MAX_NATIVE_INT_PRECISION
+	@brief maximal precision of a NUMBER column fetched as 64-bit integer
+
+	Macro for the maximal precision of a NUMBER(p,0) column fetched as 64-bit integer (SQLT_INT)
+	*/
+	#define MAX_NATIVE_INT_PRECISION 18
+
+	/*!
+	@def DIRPATH_STREAM_BUFFER_SIZE
+	@brief default size of the direct path stream buffer
+
+	Macro for the default size (in bytes) of the stream buffer a direct path load converts rows into.
+	*/
+	#define DIRPATH_STREAM_BUFFER_SIZE (1024*1024)
+
+	/*!
+	@def SESSION_POOL_MAX_SESSIONS
+	@brief default maximal number of sessions of a session pool
+
+	Macro for the default maximal number of sessions of a session pool.
+	*/
+	#define SESSION_POOL_MAX_SESSIONS 8
+
+	/*!
+	@def SESSION_POOL_POLL_INTERVAL
+	@brief interval to retry borrowing a session
+
+	Macro for the interval (in milli-seconds) to retry borrowing a session, while every session of the pool is busy.
+	*/
+	#define SESSION_POOL_POLL_INTERVAL 10
+
+	/*!
+	@def STATEMENT_CACHE_SIZE
+	@brief default number of prepared statements cached by a connection
+
+	Macro for the default number of prepared statements a connection keeps for reuse, keyed by their SQL text.
+	*/
+	#define STATEMENT_CACHE_SIZE 32
+
+	/*!
+	@def FETCH_BUFFER_POOL_SIZE
+	@brief default number of idle fetch buffer arenas kept by a connection
+
+	Macro for the default number of fetch buffer arenas a connection keeps for reuse by its next result sets, keyed by their size.
+	*/
+	#define FETCH_BUFFER_POOL_SIZE 8
+
+	/*!
+	@def FETCH_BUFFER_POOL_MAX_BYTES
+	@brief maximal number of bytes of idle fetch buffer arenas kept by a connection
+
+	Macro for the maximal number of bytes the idle fetch buffer arenas of a connection may hold all together.
+	*/
+	#define FETCH_BUFFER_POOL_MAX_BYTES (64*1024*1024)
+
+	/*!
+	@def ASYNC_REACTOR_POLL_INTERVAL
+	@brief default interval to re-issue the calls still executing
+
+	Macro for the default interval (in milli-seconds) an asynchronous reactor waits between two rounds over its pending calls,
+	and a synchronous call on a non-blocking connection waits before issuing the call again.
+	*/
+	#define ASYNC_REACTOR_POLL_INTERVAL 1
+
+	/*!
+	@def PARALLEL_SELECT_PREDICATE_MARKER
+	@brief marker of the partition predicate in a parallel select query
+
+	Macro for the marker replaced by the predicate of each partition in the query of a parallel select.
+	*/
+	#define PARALLEL_SELECT_PREDICATE_MARKER _T("{PARTITION}")
+
 	/*!
 	@def ERROR_FORMAT_MAX_MSG_LEN
 	@brief The maximum length of the error message
@@ -127,6 +274,23 @@ namespace epol
 	*/
 	#define ERROR_FORMAT_MAX_MSG_LEN 1024
 
+	/*!
+	@def ERROR_TEXT_MAX_LEN
+	@brief The maximum length of the Oracle error text kept by an error
+
+	Macro for the maximum length (in characters) of the Oracle error text an error takes from the error handle.
+	*Large enough for a whole PL/SQL error stack (ORA-06512 lines), beyond OCI_ERROR_MAXMSG_SIZE
+	*/
+	#define ERROR_TEXT_MAX_LEN 4000
+
+	/*!
+	@def ERROR_SOURCE_MAX_LEN
+	@brief The maximum length of the source file name kept by an error
+
+	Macro for the maximum length (in characters) of the source file name an error copies, the end of a longer path is kept.
+	*/
+	#define ERROR_SOURCE_MAX_LEN 260
+
 	/*!
 	@def FIRST_COLUMN_NO
 	@brief The index of the first column in a result set
@@ -173,7 +337,11 @@ namespace epol
 		/// Column not found error
 		EC_COLUMN_NOT_FOUND,
 		/// Internal error
-		EC_INTERNAL
+		EC_INTERNAL,
+		/// Operation not allowed in the fetch mode of the result set
+		EC_BAD_FETCH_MODE,
+		/// Direct path load not prepared error
+		EC_DIRPATH_NOT_PREPARED
 	}ErrorCodesEnum;
 
 	/// Enumberator for error type
@@ -45,11 +45,82 @@ An Interface for OracleDB Error.
 
 namespace epol {
 
+	/*!
+	@struct Status epOraError.h
+	@brief This is a struct representing the outcome of a call that does not throw
+
+	Interface for the outcome of the Try methods, holding the error codes only (no text).
+	*/
+	struct EP_ORACLELIB Status
+	{
+		/*!
+		Default Constructor
+
+		Create the status of a successful call
+		*/
+		Status ();
+
+		/*!
+		Default Constructor
+
+		Create the status of given OCI result, taking the Oracle error code from the error handle
+		@param[in] oraErr the OCI result of the call
+		@param[in] errorHandle the Oracle error handle
+		*/
+		Status (int oraErr, OCIError *errorHandle);
+
+		/*!
+		Return whether the call succeeded
+		@return true if succeeded, otherwise false.
+		*/
+		inline bool IsSucceeded () const
+		{
+			return (m_type == ET_UNKNOWN);
+		}
+
+		/*!
+		Return whether the call found no (more) rows
+		@return true if OCI_NO_DATA or ORA-01403, otherwise false.
+		*/
+		bool IsNoData () const;
+
+		/*!
+		Return whether the call violated a unique constraint
+		@return true if ORA-00001, otherwise false.
+		*/
+		bool IsDuplicateKey () const;
+
+		/*!
+		Return whether the call could not lock the rows in time
+		@return true if ORA-00054 or ORA-30006, otherwise false.
+		*/
+		bool IsLockTimeout () const;
+
+		/*!
+		Throw the error of the call as OraError
+		*Does nothing if the call succeeded; the error has no Oracle error text
+		@param[in] sourceName the name of the source where error occurred
+		@param[in] lineNumber the line of the source where error occurred
+		*/
+		void Throw (const TCHAR *sourceName = NULL, long lineNumber = -1) const;
+
+		/// the type of the error (ET_UNKNOWN if succeeded)
+		ErrorTypesEnum	m_type;
+		/// the OCI result if Oracle error, or the library error code
+		int				m_code;
+		/// Oracle's error code (ORA-xxxxx)
+		unsigned int	m_oraCode;
+		/// the number of rows processed (execution) or fetched so far (fetch)
+		unsigned __int64	m_rowCount;
+	};
+
 	/*! 
 	@class OraError epOraError.h
 	@brief This is a class representing OraError 
 
 	Interface for the OraError.
+	*The codes and the Oracle error text are taken when the error is created,
+	*the description is put together only when asked for.
 	*/
 	class EP_ORACLELIB OraError
 	{
@@ -99,6 +170,16 @@ namespace epol {
 		*/
 		OraError (const TCHAR *sourceName = NULL, long lineNumber = -1,const TCHAR *format = NULL, ...);
 
+		/*!
+		Default Constructor
+
+		Create the Error object with given status of a Try call
+		@param[in] status the status of the failed call
+		@param[in] sourceName the name of the source where error occurred
+		@param[in] lineNumber the line of the source where error occurred
+		*/
+		OraError (const Status &status, const TCHAR *sourceName = NULL, long lineNumber = -1);
+
 		/*!
 		Default Copy Constructor
 
@@ -120,6 +201,58 @@ namespace epol {
 		*/
 		epl::EpTString Details() const;
 
+		/*!
+		Return the description of the error
+		*Put together on the first call
+		@return the description of the error in text
+		*/
+		const epl::EpTString &GetDescription () const;
+
+		/*!
+		Return the type of the error
+		@return the type of the error
+		*/
+		inline ErrorTypesEnum GetType () const
+		{
+			return m_type;
+		}
+
+		/*!
+		Return the error code
+		@return the OCI result if Oracle error, the library error code if EpOraLibrary error
+		*/
+		inline int GetCode () const
+		{
+			return m_code;
+		}
+
+		/*!
+		Return Oracle's error code
+		@return the ORA-xxxxx code, 0 if none
+		*/
+		inline unsigned int GetOraCode () const
+		{
+			return m_oraCode;
+		}
+
+		/*!
+		Return the source file where the error occurred
+		@return the name of the source, NULL if unknown
+		*/
+		inline const TCHAR *GetSource () const
+		{
+			return m_source[0] ? m_source : NULL;
+		}
+
+		/*!
+		Return the line number where the error occurred
+		@return the line of the source, -1 if unknown
+		*/
+		inline long GetLineNumber () const
+		{
+			return m_lineNo;
+		}
+
 	private:
 
 		/*!
@@ -134,45 +267,80 @@ namespace epol {
 		};
 
 		/*!
-		Set-up given Oracle error details
-		@param[in] oraErr the Oracle Error Code
+		Initialize member variables
+		@param[in] type the type of the error
+		@param[in] code the error code
+		@param[in] sourceName the name of the source where error occurred
+		@param[in] lineNumber the line of the source where error occurred
+		*/
+		void initialize (ErrorTypesEnum type, int code, const TCHAR *sourceName, long lineNumber);
+
+		/*!
+		Take the Oracle error code and text of given result out of the handle
 		@param[in] errorHandle the Oracle error handle
 		@param[in] envHandle the Oracle environment handle
 		*/
-		void oracleError (int oraErr,OCIError *errorHandle, OCIEnv *envHandle);
+		void oracleError (OCIError *errorHandle, OCIEnv *envHandle);
 
 		/*!
-		Set-up given EpOraLibrary error details
-		@param[in] oralibErr the EpOraLibrary Error Code
+		Format printf-like text into the error text buffer
+		@param[in] format the format of the text
 		*/
-		void oralibError (int oralibErr);
+		void formatErrorText (const TCHAR *format, ...);
 
 		/*!
-		Set-up given WinAPI error details
+		Take the WinAPI error code and text
 		*/
 		void winapiError ();
 
 		/*!
-		Format printf-like message and concats it to the description
+		Format printf-like message into the message buffer
 		@param[in] format the format of the message
 		@param[in] va the variadic argument
 		*/
-		void concatMessage (const TCHAR *format, va_list va);
+		void formatMessage (const TCHAR *format, va_list va);
+
+		/*!
+		Return whether the OCI result carries details in the error handle
+		@param[in] oraErr the OCI result
+		@return true if the error handle holds details, otherwise false.
+		*/
+		static bool hasDetails (int oraErr);
+
+		/*!
+		Return the text of given OCI result
+		@param[in] oraErr the OCI result
+		@return the text of the result
+		*/
+		static const TCHAR *oracleText (int oraErr);
+
+		/*!
+		Return the text of given EpOraLibrary error code
+		@param[in] oralibErr the EpOraLibrary Error Code
+		@return the text of the error
+		*/
+		static const TCHAR *oralibText (int oralibErr);
 
 		/// the type of the error
 		ErrorTypesEnum	m_type;	
-		/// the error code if library error or -1 if Oracle error
+		/// the OCI result if Oracle error, the library error code if EpOraLibrary error
 		int		m_code;		
 		/// Oracle's error code (ORA-xxxxx)
 		unsigned int m_oraCode;
 		/// Windows API error code
 		unsigned long	m_winapiCode;
-		/// the description of error in text
-		epl::EpTString	m_description;
+		/// the Oracle (or Windows API) error text
+		TCHAR	m_errorText[ERROR_TEXT_MAX_LEN];
+		/// the formatted message of the thrower
+		TCHAR	m_message[ERROR_FORMAT_MAX_MSG_LEN];
 		/// the source file where the error occurred
-		epl::EpTString	m_source;			
+		TCHAR	m_source[ERROR_SOURCE_MAX_LEN];
 		/// the line number where the error occurred
 		long		m_lineNo;
+		/// the description of error in text (put together on demand)
+		mutable epl::EpTString	m_description;
+		/// flag whether the description is put together
+		mutable bool	m_isDescribed;
 
 	};
 
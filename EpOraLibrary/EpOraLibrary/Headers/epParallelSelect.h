@@ -0,0 +1,186 @@
+/*! 
+@file epParallelSelect.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Parallel Select Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Parallel Select.
+*/
+#ifndef __EP_PARALLEL_SELECT_H__
+#define __EP_PARALLEL_SELECT_H__
+
+#include "epOraLib.h"
+#include "epOraDefines.h"
+#include <vector>
+
+namespace epol
+{
+	class ResultSet;
+	class SessionPool;
+
+	/*!
+	@class PartitionHandler epParallelSelect.h
+	@brief This is a class representing the consumer of the partitions of a Parallel Select
+
+	Interface for the consumer of the rows of each partition, called on the worker threads.
+	*/
+	class EP_ORACLELIB PartitionHandler
+	{
+	public:
+		/*!
+		Default Destructor
+		*/
+		virtual ~PartitionHandler ()
+		{
+		}
+
+		/*!
+		Consume the rows of a partition
+		*Called concurrently for different partitions, each on its own session
+		@param[in] partition the index of the partition (0 based)
+		@param[in] resultSet the result set of the partition, only valid within this call
+		*/
+		virtual void OnPartition (unsigned int partition, ResultSet &resultSet) = 0;
+	};
+
+	/*!
+	@class ParallelSelect epParallelSelect.h
+	@brief This is a class representing a select query split into partitions
+
+	Interface for running the partitions of a select query in parallel, each on its own pooled session.
+	*The predicate of each partition replaces PARALLEL_SELECT_PREDICATE_MARKER in the query,
+	*or filters the whole query if the marker is absent
+	*(Ex: "select id, name from item where {PARTITION}" with AddHashPartitions(_T("id"), 8))
+	*/
+	class EP_ORACLELIB ParallelSelect
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the parallel select
+		@param[in] pool the session pool to borrow the sessions from
+		@param[in] selectStmt the select query
+		@param[in] workerCount the maximal number of partitions run at once (0 for one per partition)
+		*/
+		ParallelSelect (SessionPool &pool, const TCHAR *selectStmt, unsigned int workerCount = 0);
+
+		/*!
+		Default Destructor
+		*/
+		~ParallelSelect ();
+
+		/*!
+		Add a partition filtered by given predicate
+		@param[in] predicate the SQL condition selecting the rows of the partition
+		*/
+		void AddPartition (const TCHAR *predicate);
+
+		/*!
+		Add partitions by hash buckets of given expression (ORA_HASH)
+		@param[in] expression the expression to hash (Ex: a key column)
+		@param[in] partitionCount the number of partitions to add
+		*/
+		void AddHashPartitions (const TCHAR *expression, unsigned int partitionCount);
+
+		/*!
+		Add partitions by row id ranges over the extents of given table
+		*Each partition covers its own extents of about the same number of blocks, so each session only reads its own extents
+		*The extents are read at once from DBA_EXTENTS and DBA_OBJECTS (the session needs to select from them),
+		*so the rows of extents added later are left out
+		@param[in] tableName the name of the table as in the data dictionary (Ex: "ITEM")
+		@param[in] partitionCount the maximal number of partitions to add
+		@param[in] owner the owner of the table (NULL for the current schema)
+		@param[in] rowidExpression the row id of the table in the query (Ex: "t.rowid")
+		@return the number of partitions added (fewer than partitionCount if the table has too few extents)
+		*/
+		unsigned int AddRowidPartitions (const TCHAR *tableName, unsigned int partitionCount, const TCHAR *owner = NULL, const TCHAR *rowidExpression = _T("ROWID"));
+
+		/*!
+		Run every partition and wait for them
+		*Throws the error of the first failed partition, once every partition is done
+		@param[in] handler the consumer of the partitions
+		@param[in] priority the priority of the partition jobs
+		@return the total number of rows fetched
+		*/
+		unsigned __int64 Run (PartitionHandler &handler, epl::Priority priority = PRIORITY_NORMAL);
+
+		/*!
+		Return the number of partitions
+		@return the number of partitions
+		*/
+		inline unsigned int GetPartitionCount () const
+		{
+			return static_cast <unsigned int> (m_predicates.size ());
+		}
+
+		/*!
+		Return the query run for given partition
+		@param[in] partition the index of the partition
+		@return the query of the partition
+		*/
+		epl::EpTString GetPartitionStatement (unsigned int partition) const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Class cannot be copied
+		@param select the ParallelSelect object to copy
+		*/
+		ParallelSelect (const ParallelSelect& select)
+		{
+			/* could not be copy-constructed */
+		}
+
+		/*!
+		Copy Operator
+
+		*Class cannot be copied
+		@param select the ParallelSelect object to copy
+		*/
+		ParallelSelect& operator = (const ParallelSelect& select)
+		{
+			return (*this); /* could not be copy-constructed */
+		}
+
+		/// the session pool to borrow the sessions from
+		SessionPool		*m_pool;
+		/// the select query
+		epl::EpTString	m_selectStmt;
+		/// the predicates of the partitions
+		std::vector <epl::EpTString>	m_predicates;
+		/// the maximal number of partitions run at once
+		unsigned int	m_workerCount;
+	};
+}
+
+#endif //__EP_PARALLEL_SELECT_H__
@@ -67,15 +67,49 @@ namespace epol {
 		*/
 		inline bool IsNull () const 
 		{
-			return (m_indicator == ORADATA_NULL); 
+			return (!m_indicators || m_indicators [m_currentCell] == ORADATA_NULL); 
 		};
 
+		/*!
+		Select the cell of an array parameter that following accessors and assignments use
+		*(Ex: param[i] = value;)
+		@param[in] cell the index of the cell (0 based)
+		@return the reference to current Parameter
+		*/
+		Parameter& operator [] (unsigned int cell);
+
+		/*!
+		Return the number of cells of the parameter (1 for non-array parameters)
+		@return the number of cells of the parameter
+		*/
+		inline unsigned int GetArraySize () const
+		{
+			return m_arraySize;
+		}
+
 		/*!
 		Returns the parameter data by converting it to String
 		@return parameter data in string format.
 		*/
 		epl::EpTString ToString () const;
 
+		/*!
+		Returns the parameter data as a pointer into the fetch buffer without copying
+		*The text is NULL-terminated and stays valid until the parameter is assigned or the statement is executed again
+		@param[out] retLength if not NULL, receives the length of the text in characters
+		@return the pointer to the parameter text
+		*/
+		const TCHAR *GetText (unsigned int *retLength = NULL) const;
+
+		/*!
+		Copies the parameter data to given buffer
+		*The text is truncated to fit and always NULL-terminated
+		@param[out] buffer the buffer to copy to
+		@param[in] capacity the size of the buffer in characters
+		@return the number of characters copied (excluding the terminator)
+		*/
+		unsigned int CopyTo (TCHAR *buffer, unsigned int capacity) const;
+
 		/*!
 		Returns the parameter data by converting it to double
 		@return parameter data in double format.
@@ -88,6 +122,18 @@ namespace epol {
 		*/
 		long ToLong () const;
 
+		/*!
+		Returns the parameter data by converting it to 64-bit integer
+		@return parameter data in 64-bit integer format.
+		*/
+		__int64 ToInt64 () const;
+
+		/*!
+		Returns the parameter data by converting it to unsigned 64-bit integer
+		@return parameter data in unsigned 64-bit integer format.
+		*/
+		unsigned __int64 ToUInt64 () const;
+
 		/*!
 		Returns the parameter data by converting it to DateTime
 		@return parameter data in DateTime format.
@@ -104,7 +150,8 @@ namespace epol {
 		*/
 		inline void ToNull () 
 		{ 
-			m_indicator = ORADATA_NULL; 
+			if (m_indicators)
+				m_indicators [m_currentCell] = ORADATA_NULL; 
 		}
 
 		/*!
@@ -121,6 +168,13 @@ namespace epol {
 		*/
 		Parameter& operator = (double value);
 
+		/*!
+		Set the parameter value to given int value
+		@param[in] value the int value to set for parameter value
+		@return the reference to current Parameter
+		*/
+		Parameter& operator = (int value);
+
 		/*!
 		Set the parameter value to given long value
 		@param[in] value the long value to set for parameter value
@@ -128,6 +182,22 @@ namespace epol {
 		*/
 		Parameter& operator = (long value);
 
+		/*!
+		Set the parameter value to given 64-bit integer value
+		*A native parameter (DT_INT32, DT_INT64, DT_UINT64, DT_DOUBLE) takes the value as is, without OCINumber conversion
+		@param[in] value the 64-bit integer value to set for parameter value
+		@return the reference to current Parameter
+		*/
+		Parameter& operator = (__int64 value);
+
+		/*!
+		Set the parameter value to given unsigned 64-bit integer value
+		*A native parameter (DT_INT32, DT_INT64, DT_UINT64, DT_DOUBLE) takes the value as is, without OCINumber conversion
+		@param[in] value the unsigned 64-bit integer value to set for parameter value
+		@return the reference to current Parameter
+		*/
+		Parameter& operator = (unsigned __int64 value);
+
 		/*!
 		Set the parameter value to given DateTime value
 		@param[in] dateTime the DateTime value to set for parameter value
@@ -174,8 +244,10 @@ namespace epol {
 		@param[in] name the name of the parameter
 		@param[in] type the type of the parameter value
 		@param[in] fetchSize the size of fetching
+		@param[in] arraySize the number of cells to bind (see Statement::Bind)
+		@param[in] maxTextLength the maximal length of a text cell in characters (0 for default)
 		*/
-		Parameter (Statement *to, const TCHAR *name, DataTypesEnum type = DT_UNKNOWN, unsigned int fetchSize = FETCH_SIZE);
+		Parameter (Statement *to, const TCHAR *name, DataTypesEnum type = DT_UNKNOWN, unsigned int fetchSize = FETCH_SIZE, unsigned int arraySize = 1, unsigned int maxTextLength = 0);
 
 		/*!
 		Default Destructor
@@ -223,16 +295,43 @@ namespace epol {
 		@param[in] name the name of the parameter
 		@param[in] type the type of the parameter value
 		@param[in] fetchSize the size of fetching
+		@param[in] arraySize the number of cells to bind
+		@param[in] maxTextLength the maximal length of a text cell in characters (0 for default)
 		*/
-		void attach (Statement *to, const TCHAR *name, DataTypesEnum type = DT_UNKNOWN, unsigned int fetchSize = FETCH_SIZE);
+		void attach (Statement *to, const TCHAR *name, DataTypesEnum type = DT_UNKNOWN, unsigned int fetchSize = FETCH_SIZE, unsigned int arraySize = 1, unsigned int maxTextLength = 0);
 
 		/*!
 		Set-up name, type, oci_type and size, depending on type value
 		*when type is set to DT_UNKNOWN type is taken from name's prefix
 		@param[in] paramName the name of the parameter
 		@param[in] type the type of the parameter
+		@param[in] maxTextLength the maximal length of a text cell in characters (0 for default)
 		*/
-		void setupType (const TCHAR *paramName, DataTypesEnum type = DT_UNKNOWN);
+		void setupType (const TCHAR *paramName, DataTypesEnum type = DT_UNKNOWN, unsigned int maxTextLength = 0);
+
+		/*!
+		Return whether the parameter can serve a new binding with given settings
+		*(used to reuse the buffers of a cached statement)
+		@param[in] type the type of the parameter (DT_UNKNOWN matches any)
+		@param[in] arraySize the number of cells to bind
+		@param[in] maxTextLength the maximal length of a text cell in characters (0 for default)
+		@return true if the parameter can be reused, otherwise false.
+		*/
+		bool isCompatible (DataTypesEnum type, unsigned int arraySize, unsigned int maxTextLength) const;
+
+		/*!
+		Set every cell to NULL and release the result set of a cursor, for the next user of a cached statement
+		*/
+		void reset ();
+
+		/*!
+		Return the buffer of the current cell
+		@return the buffer of the current cell
+		*/
+		inline char *currentBuffer () const
+		{
+			return (m_fetchBuffer + m_size * m_currentCell);
+		}
 
 		/*!
 		Bind an input and/or output parameter to the given statement.
@@ -256,12 +355,16 @@ namespace epol {
 		/// the number of bytes required for fetching
 		unsigned short	m_size;	
 
-		/// the flag whether the parameter data is NULL or not
-		short m_indicator;
-		/// the number of bytes returned (used for text)
-		unsigned short m_dataLen;
-		/// the buffer for fetching
+		/// array with the flags whether the cell data is NULL or not
+		short *m_indicators;
+		/// array with the number of bytes of each cell (used for text)
+		unsigned short *m_dataLengths;
+		/// the buffer for fetching (m_size bytes per cell)
 		char *m_fetchBuffer;
+		/// the number of cells
+		unsigned int m_arraySize;
+		/// the cell used by the accessors
+		unsigned int m_currentCell;
 
 		/// the flag whether the paramet is array or not
 		bool m_isArray;
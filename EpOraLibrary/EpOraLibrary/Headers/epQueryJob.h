@@ -0,0 +1,311 @@
+/*! 
+@file epQueryJob.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Query Job Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Query Job.
+*/
+#ifndef __EP_QUERY_JOB_H__
+#define __EP_QUERY_JOB_H__
+
+#include "epOraLib.h"
+#include "epOraDefines.h"
+#include "epDateTime.h"
+#include <vector>
+
+namespace epol
+{
+	class Connection;
+	class ResultSet;
+	class OraError;
+	class QueryJob;
+	class AsyncExecutor;
+
+	/*!
+	@class QueryCallback epQueryJob.h
+	@brief This is a class representing the completion delegate of a Query Job
+
+	Interface for the callbacks of a query job, called on the worker thread which runs the job.
+	*/
+	class EP_ORACLELIB QueryCallback
+	{
+	public:
+		/*!
+		Default Destructor
+		*/
+		virtual ~QueryCallback ()
+		{
+		}
+
+		/*!
+		Called with the result set of a select query, before the job is done
+		*The result set can only be used within this call
+		@param[in] job the job which selected the rows
+		@param[in] resultSet the result set of the query
+		*/
+		virtual void OnResultSet (QueryJob &job, ResultSet &resultSet)
+		{
+		}
+
+		/*!
+		Called when the job is done, successfully or not
+		@param[in] job the job done
+		*/
+		virtual void OnComplete (QueryJob &job) = 0;
+	};
+
+	/*!
+	@class QueryJob epQueryJob.h
+	@brief This is a class representing a query run by an AsyncExecutor
+
+	Interface for the future-like handle of a query, holding its SQL, its bind values and its outcome.
+	*/
+	class EP_ORACLELIB QueryJob:public epl::BaseJob
+	{
+		// friends
+		friend class QueryJobProcessor;
+		friend class AsyncExecutor;
+
+	public:
+		/*!
+		Default Constructor
+
+		Create the job for given SQL statement
+		@param[in] sqlStmt the SQL statement to run
+		@param[in] priority the priority of the job in the queue of the worker
+		@param[in] callback the completion delegate (NULL for none, not owned)
+		@param[in] executeMode the execute mode of a non-select statement
+		*/
+		QueryJob (const TCHAR *sqlStmt, epl::Priority priority = PRIORITY_NORMAL, QueryCallback *callback = NULL, ExecuteModesEnum executeMode = EM_DEFAULT);
+
+		/*!
+		Bind a text value to the named variable
+		@param[in] name the name of the variable
+		@param[in] text the value
+		@return the reference to this job
+		*/
+		QueryJob &Bind (const TCHAR *name, const TCHAR *text);
+
+		/*!
+		Bind a number value to the named variable
+		@param[in] name the name of the variable
+		@param[in] value the value
+		@return the reference to this job
+		*/
+		QueryJob &Bind (const TCHAR *name, double value);
+
+		/*!
+		Bind a number value to the named variable
+		@param[in] name the name of the variable
+		@param[in] value the value
+		@return the reference to this job
+		*/
+		QueryJob &Bind (const TCHAR *name, long value);
+
+		/*!
+		Bind a 64-bit integer value to the named variable
+		*Bound as native DT_INT64, so the value is exact
+		@param[in] name the name of the variable
+		@param[in] value the value
+		@return the reference to this job
+		*/
+		QueryJob &Bind (const TCHAR *name, __int64 value);
+
+		/*!
+		Bind a date value to the named variable
+		@param[in] name the name of the variable
+		@param[in] dateTime the value
+		@return the reference to this job
+		*/
+		QueryJob &Bind (const TCHAR *name, const DateTime &dateTime);
+
+		/*!
+		Bind NULL to the named variable
+		@param[in] name the name of the variable
+		@param[in] type the Data type for the parameter
+		@return the reference to this job
+		*/
+		QueryJob &BindNull (const TCHAR *name, DataTypesEnum type);
+
+		/*!
+		Wait until the job is done
+		*Throws the error of the query, if it failed
+		@param[in] waitTimeInMilliSec the time to wait in milli-seconds
+		@return true if done, false if timed out
+		*/
+		bool Wait (unsigned int waitTimeInMilliSec = WAITTIME_INIFINITE);
+
+		/*!
+		Return whether the job is done
+		@return true if done (successfully or not), otherwise false.
+		*/
+		inline bool IsDone () const
+		{
+			return m_isDone;
+		}
+
+		/*!
+		Return whether the job is done without error
+		@return true if succeeded, otherwise false.
+		*/
+		inline bool IsSucceeded () const
+		{
+			return m_isDone && m_error == NULL;
+		}
+
+		/*!
+		Return the error of the failed job
+		@return the error of the job, NULL if none
+		*/
+		inline const OraError *GetError () const
+		{
+			return m_error;
+		}
+
+		/*!
+		Return the number of rows processed (or fetched by the select callback)
+		@return the number of rows of the query
+		*/
+		inline unsigned __int64 GetRowCount () const
+		{
+			return m_rowCount;
+		}
+
+		/*!
+		Return the SQL statement of the job
+		@return the SQL statement
+		*/
+		inline const epl::EpTString &GetSQL () const
+		{
+			return m_sqlStmt;
+		}
+
+	protected:
+		/*!
+		Default Destructor
+
+		Releases the error of the job
+		*Use ReleaseObj instead
+		*/
+		virtual ~QueryJob ();
+
+		/*!
+		Job report callback
+		@param[in] status the status of the job
+		*/
+		virtual void handleReport (const JobStatus status);
+
+	private:
+		/// Structure for a bind value of a query
+		struct BindValue
+		{
+			/// the name of the variable
+			epl::EpTString	m_name;
+			/// the data type of the value
+			DataTypesEnum	m_type;
+			/// the text value
+			epl::EpTString	m_text;
+			/// the number value
+			double			m_number;
+			/// the 64-bit integer value
+			__int64			m_integer;
+			/// the date value
+			DateTime		m_dateTime;
+			/// flag whether the value is NULL
+			bool			m_isNull;
+		};
+
+		/*!
+		Default Copy Constructor
+
+		*Class cannot be copied
+		@param job the QueryJob object to copy
+		*/
+		QueryJob (const QueryJob& job) :BaseJob(job)
+		{
+			/* could not be copy-constructed */
+		}
+
+		/*!
+		Copy Operator
+
+		*Class cannot be copied
+		@param job the QueryJob object to copy
+		*/
+		QueryJob& operator = (const QueryJob& job)
+		{
+			return (*this); /* could not be copy-constructed */
+		}
+
+		/*!
+		Add a bind value
+		@param[in] name the name of the variable
+		@param[in] type the data type of the value
+		@return the value added
+		*/
+		BindValue &addBind (const TCHAR *name, DataTypesEnum type);
+
+		/*!
+		Run the query on given connection and signal the outcome
+		*Called from the worker thread
+		@param[in] conn the connection to use
+		*/
+		void run (Connection &conn);
+
+		/*!
+		Signal the outcome of the job
+		*/
+		void finish ();
+
+		/// the SQL statement
+		epl::EpTString	m_sqlStmt;
+		/// the bind values
+		std::vector <BindValue>	m_binds;
+		/// the completion delegate
+		QueryCallback	*m_callback;
+		/// the execute mode of a non-select statement
+		ExecuteModesEnum	m_executeMode;
+		/// the executor the job is submitted to (NULL if not submitted)
+		AsyncExecutor	*m_executor;
+
+		/// event raised when the job is done
+		epl::EventEx	m_doneEvent;
+		/// the error of the job (NULL if succeeded)
+		OraError		*m_error;
+		/// the number of rows of the query
+		unsigned __int64	m_rowCount;
+		/// flag whether the job is done
+		volatile bool	m_isDone;
+	};
+}
+
+#endif //__EP_QUERY_JOB_H__
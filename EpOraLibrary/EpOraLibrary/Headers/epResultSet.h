@@ -39,11 +39,16 @@ An Interface for OracleDB Result Set.
 
 #include "epOraLib.h"
 #include <vector>
-#include <map>
 #include "epStatement.h"
+#include "epRowMapping.h"
 #include "oci.h"
 namespace epol {
 
+	class Column;
+	class FetchWorker;
+	class AsyncOperation;
+	class AsyncReactor;
+
 	/*! 
 	@class ResultSet epResultSet.h
 	@brief This is a class representing OracleDB Result Set 
@@ -57,6 +62,8 @@ namespace epol {
 		friend class Statement;
 		friend class Parameter;
 		friend class Column;
+		friend class FetchWorker;
+		friend class FetchOperation;
 
 
 	public:
@@ -84,8 +91,52 @@ namespace epol {
 		*/
 		bool Next ();
 
+		/*!
+		Traverse to the next row, returning the error of the fetch instead of throwing it
+		*For hot paths where errors are expected, the error text is not taken
+		@return the status of the traversal (OCI_NO_DATA code if at last row) with the number of rows fetched so far
+		*/
+		Status TryNext ();
+
+		/*!
+		Traverse to the next batch of rows
+		*The batch holds the rows from the current row to the end of the fetched block,
+		*and the current row becomes the last row of the batch.
+		*Use Column::GetView to access the rows of the batch without copying.
+		@return true if a batch is available, false if at end of data
+		*/
+		bool NextBatch ();
+
+		/*!
+		Return the number of rows in the current batch
+		@return the number of rows in the current batch
+		*/
+		inline unsigned int GetBatchSize () const
+		{
+			return m_batchSize;
+		}
+
+		/*!
+		Return the number of rows requested on each fetch
+		@return the number of rows requested on each fetch
+		*/
+		inline unsigned int GetFetchSize () const
+		{
+			return m_fetchCount;
+		}
+
+		/*!
+		Return the number of rows fetched so far
+		@return the number of rows fetched so far
+		*/
+		inline unsigned __int64 GetRowsFetched () const
+		{
+			return m_rowsFetched;
+		}
+
 		/*!
 		Get the column by column name within current row
+		*Its values cannot be read in FM_BOUND_ROWS mode (EC_BAD_FETCH_MODE)
 		@param[in] columnName the name of the column to get
 		@return the column with given name within current row
 		*/
@@ -93,11 +144,59 @@ namespace epol {
 
 		/*!
 		Get the column by column index within current row
+		*Its values cannot be read in FM_BOUND_ROWS mode (EC_BAD_FETCH_MODE)
 		@param[in] columnIndex the index of the column to get
 		@return the column at given index within current row
 		*/
 		Column& operator [] (unsigned short columnIndex);
 
+		/*!
+		Get the index of the column with given name
+		*The index stays valid for the life of the Result Set,
+		*so it can be looked up once and used with operator[] for every row
+		*Column names are compared case-insensitively (ASCII only)
+		@param[in] columnName the name of the column to find
+		@return the index of the column with given name
+		*/
+		unsigned short ColumnIndex (const TCHAR *columnName) const;
+
+		/*!
+		Bind caller's array of rows as the fetch target
+		*The result set must be selected with FM_BOUND_ROWS.
+		*Each FetchBoundRows call writes up to capacity rows straight into the array;
+		*the rows can be bound again (e.g. to another array) between fetches.
+		@param[in] mapping the mapping of the row fields to the select-list
+		@param[in] rows the array of rows to fetch into
+		@param[in] capacity the number of rows in the array
+		*/
+		template <typename RowType>
+		void BindRows (const RowMapping <RowType> &mapping, RowType *rows, unsigned int capacity)
+		{
+			EP_ASSERT (rows && capacity > 0);
+
+			std::vector <RowFieldDefine> defines;
+			mapping.GetDefines (rows, defines);
+			bindRows (defines, sizeof (RowType), capacity);
+		}
+
+		/*!
+		Fetch the next block of rows into the bound rows
+		@return the number of rows fetched, 0 if at end of data
+		*/
+		unsigned int FetchBoundRows ();
+
+		/*!
+		Start fetching the next block of rows, and return at once
+		*The rows left in the current block are skipped; when the operation is done the current row is
+		*the first row of the new block (FM_BOUND_ROWS: the rows are in the bound array)
+		*The call is driven to its completion by given reactor; the connection should be opened in non-blocking mode
+		*and must not be used by any other call until the operation is done
+		@param[in] reactor the reactor to drive the fetch
+		@return the operation in progress (release it when done with it)
+		@remark not available in FM_PIPELINED mode, which already fetches in background
+		*/
+		AsyncOperation *FetchAsync (AsyncReactor &reactor);
+
 
 	private:
 		/*!
@@ -106,9 +205,10 @@ namespace epol {
 		*Cannot be created publicly
 		@param[in] rs the OCI statement handle.
 		@param[in] useConnection the connection object to use
-		@param[in] fetchSize the size of fetching
+		@param[in] fetchSize the number of rows to request on each fetch (0 to derive it from the fetch memory budget)
+		@param[in] fetchMode the fetch mode
 		*/
-		ResultSet (OCIStmt *rs, Connection *useConnection,unsigned int fetchSize = FETCH_SIZE);
+		ResultSet (OCIStmt *rs, Connection *useConnection,unsigned int fetchSize = 0, FetchModesEnum fetchMode = FM_DEFAULT);
 
 		/*!
 		Default Destructor
@@ -154,9 +254,10 @@ namespace epol {
 		Attach the result set object to given statement handle
 		@param[in] rs the OCI statement handle.
 		@param[in] useConnection the connection object to use
-		@param[in] fetchSize the size of fetching
+		@param[in] fetchSize the number of rows to request on each fetch (0 to derive it from the fetch memory budget)
+		@param[in] fetchMode the fetch mode
 		*/
-		void attach (OCIStmt *rs,Connection *useConnection,unsigned int fetchSize = FETCH_SIZE);
+		void attach (OCIStmt *rs,Connection *useConnection,unsigned int fetchSize = 0, FetchModesEnum fetchMode = FM_DEFAULT);
 
 		/*!
 		Returns number of columns
@@ -165,10 +266,20 @@ namespace epol {
 		unsigned int columnsCount();
 
 		/*!
-		Returns number of rows fetched so far
-		@return the number of rows fetched so far
+		Returns the slot of the current row within the fetch buffers
+		@return the slot of the current row within the fetch buffers
+		*/
+		inline unsigned int currentSlot () const
+		{
+			return static_cast <unsigned int> (m_currentRow - m_arrayStartRow);
+		}
+
+		/*!
+		Returns the slot of the current row for reading a column value
+		*Throws EC_BAD_FETCH_MODE in FM_BOUND_ROWS mode, where the columns have no fetch buffers
+		@return the slot of the current row within the fetch buffers
 		*/
-		unsigned int rowsCount();
+		unsigned int columnSlot () const;
 
 		/*!
 		Attach the given statement object to this ResultSet
@@ -182,50 +293,168 @@ namespace epol {
 		*/
 		void describe ();
 
+		/*!
+		Work out the number of rows to request on each fetch and allocate the column buffers
+		*When no fetch size was requested, it is derived from the connection's fetch memory budget and the row width
+		*/
+		void allocateBuffers ();
+
 		/*!
 		Define columns of the result set 
 		*Bound buffers to columns
 		*/
 		void define ();
 
+		/*!
+		Bound given buffer set of each column to the result set
+		@param[in] bufferSet the buffer set to bound
+		@param[in] errorHandle the error handle to use
+		@param[out] retColumn the column which failed to be defined (may be NULL)
+		@return the OCI result
+		*/
+		int defineBufferSet (unsigned int bufferSet, OCIError *errorHandle, Column **retColumn);
+
 		/*!
 		Fetch new block of rows in the buffers
+		*In pipelined mode, takes the block fetched in background and requests the next one
 		*/
 		void fetchRows ();
 
+		/*!
+		Fetch new block of rows in the buffers without throwing the error of the fetch
+		@param[out] retErrorHandle the error handle holding the error of the fetch
+		@return the OCI result of the fetch
+		*/
+		int tryFetchRows (OCIError *&retErrorHandle);
+
+		/*!
+		Fetch new block of rows into given buffer set without throwing
+		*Called from the fetch worker thread in pipelined mode
+		@param[in] bufferSet the buffer set to fetch into
+		@param[in] errorHandle the error handle to use
+		@param[out] retRowsFetched the number of rows fetched
+		@return the OCI result
+		*/
+		int fetchArray (unsigned int bufferSet, OCIError *errorHandle, unsigned int &retRowsFetched);
+
+		/*!
+		Issue the fetch call (again, while it returns OCI_STILL_EXECUTING)
+		@param[in] errorHandle the error handle to use
+		@return the OCI result of the call
+		*/
+		int fetchStep (OCIError *errorHandle);
+
+		/*!
+		Issue the fetch call of an asynchronous fetch with the connection's error handle
+		@return the OCI result of the call
+		*/
+		int fetchAsyncStep ();
+
+		/*!
+		Return the number of rows fetched by the fetch call
+		@param[in] result the OCI result of the call
+		@param[in] errorHandle the error handle used
+		@param[out] retRowsFetched the number of rows fetched
+		@return the OCI result
+		*/
+		int rowsFetched (int result, OCIError *errorHandle, unsigned int &retRowsFetched);
+
+		/*!
+		Complete an asynchronous fetch, making the first fetched row current
+		*Throws the error of the call
+		@param[in] result the OCI result of the call
+		@return the number of rows fetched
+		*/
+		unsigned int endFetch (int result);
+
+		/*!
+		Define the select-list positions on the fields of caller's rows
+		@param[in] defines the field defines within the first row in select-list order
+		@param[in] rowSize the size of the row structure
+		@param[in] capacity the number of rows
+		*/
+		void bindRows (const std::vector <RowFieldDefine> &defines, unsigned int rowSize, unsigned int capacity);
+
+		/*!
+		Build the column name index from the described columns
+		*/
+		void buildColumnIndex ();
+
+		/*!
+		Find the position of the column with given name
+		@param[in] columnName the name of the column to find
+		@return the position in m_columns or -1 if not found
+		*/
+		int findColumn (const TCHAR *columnName) const;
+
+		/*!
+		Calculate case-insensitive hash of given column name
+		@param[in] columnName the name of the column
+		@return the hash of the name
+		*/
+		static unsigned int hashColumnName (const TCHAR *columnName);
+
+		/*!
+		Compare given column names case-insensitively
+		@param[in] name1 the first name
+		@param[in] name2 the second name
+		@return true if equal otherwise false
+		*/
+		static bool equalColumnNames (const TCHAR *name1, const TCHAR *name2);
+
 
 		/// Type Definition for Columns
 		typedef std::vector <Column*>	Columns;
-		/// Type Definition for ColumnsMap
-		typedef std::map <epl::EpTString, Column*>	ColumnsMap;
+		/// Type Definition for ColumnSlots
+		typedef std::vector <unsigned short>	ColumnSlots;
 		/// array with Result Set columns
 		Columns			m_columns;		
-		/// map with columns against their names
-		ColumnsMap		m_columnsMap;
+		/// open-addressing hash of column names (position + 1, 0 if empty)
+		ColumnSlots		m_columnSlots;
 
 		/// active connection
 		Connection		*m_conn;
 		/// OCI statement handle for the Result Set
 		OCIStmt			*m_rsHandle;
+		/// error handle of the result set (and its columns)
+		OCIError		*m_errorHandle;
 
 		/// Statement Object when created via Connection::Select
 		Statement		*m_stmt;
 		/// the number of rows to fetch at once
-		unsigned short	m_fetchCount;
+		unsigned int	m_fetchCount;
 
 		/// the number of rows fetched so far
-		unsigned int	m_rowsFetched;
+		unsigned __int64	m_rowsFetched;
 		/// current row index (0 based)
-		unsigned int	m_currentRow;
+		unsigned __int64	m_currentRow;
+		/// index of the row held in the first slot of the fetch buffers
+		unsigned __int64	m_arrayStartRow;
 		/// flag for end-of-data
 		bool			m_isEod;
+		/// flag whether the current row was handed out by NextBatch
+		bool			m_isRowConsumed;
+		/// the slot of the first row of the current batch
+		unsigned int	m_batchStart;
+		/// the number of rows in the current batch
+		unsigned int	m_batchSize;
 
 		/// flag for whether Result Set is described or not
 		bool			m_isDescribed;
 		/// flag for whether Result Set is defined or not
 		bool			m_isDefined;
-		/// the total number of rows
-		unsigned int m_nTotRow;
+
+		/// the fetch mode
+		FetchModesEnum	m_fetchMode;
+		/// the buffer set the columns currently read from
+		unsigned int	m_frontSet;
+		/// the background fetcher (pipelined mode only)
+		FetchWorker		*m_fetchWorker;
+
+		/// the memory block holding the fetch buffers of all columns (borrowed from the connection's pool)
+		char			*m_arena;
+		/// the size of the memory block in bytes
+		size_t			m_arenaBytes;
 
 	}; 
 
@@ -0,0 +1,264 @@
+/*! 
+@file epRowMapping.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Row Mapping Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Row Mapping.
+*/
+#ifndef __EP_ROW_MAPPING_H__
+#define __EP_ROW_MAPPING_H__
+
+#include "epOraLib.h"
+#include "epOraDefines.h"
+#include <vector>
+
+namespace epol
+{
+	/// Structure describing how one field of a bound row is defined
+	struct RowFieldDefine
+	{
+		/// the address of the field within the first row
+		void *m_address;
+		/// the size of the field in bytes
+		unsigned int m_size;
+		/// the Oracle's data type of the field
+		unsigned short m_ociType;
+		/// the type of the column the field accepts
+		DataTypesEnum m_colType;
+		/// the address of the indicator within the first row (NULL if not mapped)
+		short *m_indicator;
+	};
+
+	/*!
+	@struct FieldTraits epRowMapping.h
+	@brief This is a structure mapping a C++ field type to an Oracle data type
+
+	Only the specialized types can be mapped,
+	*so a field of any other type fails to compile in RowMapping::Map
+	*/
+	template <typename FieldType>
+	struct FieldTraits;
+
+	/// 32-bit integer field
+	template <>
+	struct FieldTraits <int>
+	{
+		static const unsigned short ociType = SQLT_INT;
+		static const DataTypesEnum colType = DT_NUMBER;
+	};
+
+	/// 32-bit unsigned integer field
+	template <>
+	struct FieldTraits <unsigned int>
+	{
+		static const unsigned short ociType = SQLT_UIN;
+		static const DataTypesEnum colType = DT_NUMBER;
+	};
+
+	/// 64-bit integer field
+	template <>
+	struct FieldTraits <__int64>
+	{
+		static const unsigned short ociType = SQLT_INT;
+		static const DataTypesEnum colType = DT_NUMBER;
+	};
+
+	/// 64-bit unsigned integer field
+	template <>
+	struct FieldTraits <unsigned __int64>
+	{
+		static const unsigned short ociType = SQLT_UIN;
+		static const DataTypesEnum colType = DT_NUMBER;
+	};
+
+	/// float field
+	template <>
+	struct FieldTraits <float>
+	{
+		static const unsigned short ociType = SQLT_BFLOAT;
+		static const DataTypesEnum colType = DT_NUMBER;
+	};
+
+	/// double field
+	template <>
+	struct FieldTraits <double>
+	{
+		static const unsigned short ociType = SQLT_BDOUBLE;
+		static const DataTypesEnum colType = DT_NUMBER;
+	};
+
+	/// Oracle NUMBER field
+	template <>
+	struct FieldTraits <OCINumber>
+	{
+		static const unsigned short ociType = SQLT_VNU;
+		static const DataTypesEnum colType = DT_NUMBER;
+	};
+
+	/// Oracle DATE field
+	template <>
+	struct FieldTraits <OCIDate>
+	{
+		static const unsigned short ociType = SQLT_ODT;
+		static const DataTypesEnum colType = DT_DATE;
+	};
+
+	/// NULL-terminated text field
+	template <size_t length>
+	struct FieldTraits <TCHAR [length]>
+	{
+		static const unsigned short ociType = SQLT_STR;
+		static const DataTypesEnum colType = DT_TEXT;
+	};
+
+	/*! 
+	@class RowMapping epRowMapping.h
+	@brief This is a class mapping the fields of a row structure to the select-list
+
+	Interface for mapping the fields of a row structure to the select-list positions, in order.
+	*The mapped rows can be fetched directly with ResultSet::BindRows and ResultSet::FetchBoundRows
+	@remark every select-list item must be mapped,
+	*and a field without mapped indicator fails the fetch when NULL is selected
+	*/
+	template <typename RowType>
+	class RowMapping
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Create an empty mapping
+		*/
+		RowMapping ()
+		{
+		}
+
+		/*!
+		Default Destructor
+		*/
+		~RowMapping ()
+		{
+			for (typename FieldBinders::iterator i=m_fields.begin (); i!=m_fields.end (); ++i)
+				EP_DELETE (*i);
+			m_fields.clear ();
+		}
+
+		/*!
+		Map given field to the next select-list position
+		@param[in] field the member pointer of the field
+		@param[in] indicator the member pointer of the field's NULL indicator (NULL if not mapped)
+		@return the mapping itself
+		*/
+		template <typename FieldType>
+		RowMapping &Map (FieldType RowType::*field, short RowType::*indicator = NULL)
+		{
+			m_fields.push_back (EP_NEW FieldBinder <FieldType> (field, indicator));
+			return (*this);
+		}
+
+		/*!
+		Return the number of mapped fields
+		@return the number of mapped fields
+		*/
+		inline unsigned int GetFieldCount () const
+		{
+			return static_cast <unsigned int> (m_fields.size ());
+		}
+
+		/*!
+		Get the defines of the mapped fields within given row
+		@param[in] row the row to take the field addresses from
+		@param[out] retDefines the defines in select-list order
+		*/
+		void GetDefines (RowType *row, std::vector <RowFieldDefine> &retDefines) const
+		{
+			retDefines.resize (m_fields.size ());
+			for (unsigned int i = 0; i < m_fields.size (); i++)
+				m_fields [i]->GetDefine (row, retDefines [i]);
+		}
+
+	private:
+		/// Interface for a mapped field of any type
+		class BaseFieldBinder
+		{
+		public:
+			virtual ~BaseFieldBinder ()
+			{
+			}
+			virtual void GetDefine (RowType *row, RowFieldDefine &retDefine) const = 0;
+		};
+
+		/// Mapped field of given type
+		template <typename FieldType>
+		class FieldBinder: public BaseFieldBinder
+		{
+		public:
+			FieldBinder (FieldType RowType::*field, short RowType::*indicator) : m_field (field), m_indicator (indicator)
+			{
+			}
+			virtual void GetDefine (RowType *row, RowFieldDefine &retDefine) const
+			{
+				retDefine.m_address = &(row->*m_field);
+				retDefine.m_size = sizeof (FieldType);
+				retDefine.m_ociType = FieldTraits <FieldType>::ociType;
+				retDefine.m_colType = FieldTraits <FieldType>::colType;
+				retDefine.m_indicator = m_indicator ? &(row->*m_indicator) : NULL;
+			}
+		private:
+			/// the member pointer of the field
+			FieldType RowType::*m_field;
+			/// the member pointer of the indicator
+			short RowType::*m_indicator;
+		};
+
+		/*!
+		Default Copy Constructor
+
+		Copying is not allowed
+		*/
+		RowMapping (const RowMapping &);
+
+		/*!
+		Assignment operator overloading
+
+		Assigning is not allowed
+		*/
+		RowMapping &operator = (const RowMapping &);
+
+		/// Type Definition for FieldBinders
+		typedef std::vector <BaseFieldBinder *> FieldBinders;
+		/// the mapped fields in select-list order
+		FieldBinders m_fields;
+	};
+}
+
+#endif //__EP_ROW_MAPPING_H__
@@ -0,0 +1,251 @@
+/*! 
+@file epSessionPool.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/eporalibrary>
+@date October 17, 2026
+@brief OracleDB Session Pool Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for OracleDB Session Pool.
+*/
+#ifndef __EP_SESSION_POOL_H__
+#define __EP_SESSION_POOL_H__
+
+#include "epOraLib.h"
+#include "epOraDefines.h"
+#include "epEnvironment.h"
+#include "oci.h"
+
+namespace epol
+{
+	class Connection;
+
+	/// Structure for the statistics of a session pool
+	struct SessionPoolStatistics
+	{
+		/// the number of sessions currently opened by the pool
+		unsigned int m_openCount;
+		/// the number of sessions currently borrowed
+		unsigned int m_busyCount;
+		/// the number of successful borrows
+		unsigned int m_borrowCount;
+		/// the number of borrows which found every session of the pool busy
+		unsigned int m_waitCount;
+		/// the number of borrows which timed out
+		unsigned int m_timeoutCount;
+		/// the total time spent in borrowing (in milli-seconds)
+		unsigned __int64 m_totalWaitTime;
+		/// the longest time spent in a single borrow (in milli-seconds)
+		unsigned int m_maxWaitTime;
+	};
+
+	/*!
+	@class SessionPool epSessionPool.h
+	@brief This is a class representing OracleDB Session Pool
+
+	Interface for the OCI session pool.
+	*A connection opened on the pool borrows a session which is already logged on,
+	*and gives it back to the pool when it is closed
+	*The pool is reference counted: each connection opened on it retains it
+	@remark the pool is used from many threads, so the environment requires OCI_THREADED mode
+	*/
+	class EP_ORACLELIB SessionPool:public epl::SmartObject
+	{
+		// friends
+		friend class Connection;
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the session pool object
+		@param[in] environment the environment to create the pool in
+		*/
+		SessionPool (Environment &environment);
+
+		/*!
+		Default Constructor
+
+		Create an instance of session pool and create the pool of sessions
+		@param[in] environment the environment to create the pool in
+		@param[in] serviceName the name of the service
+		@param[in] loginID the login ID for OracleDB
+		@param[in] password the password for given login ID
+		@param[in] sessionMin the number of sessions opened when the pool is created
+		@param[in] sessionMax the maximal number of sessions
+		@param[in] sessionIncrement the number of sessions opened each time the pool grows
+		@param[in] getTimeout the time to wait for a free session in milli-seconds (WAITTIME_INIFINITE to wait until one is returned)
+		@param[in] idleTimeout the time after which idle sessions are closed in seconds (0 to keep them)
+		*/
+		SessionPool (Environment &environment, const TCHAR *serviceName, const TCHAR *loginID, const TCHAR *password, unsigned int sessionMin = 1, unsigned int sessionMax = SESSION_POOL_MAX_SESSIONS, unsigned int sessionIncrement = 1, unsigned int getTimeout = WAITTIME_INIFINITE, unsigned int idleTimeout = 0);
+
+		/*!
+		Create the pool of sessions
+		@param[in] serviceName the name of the service
+		@param[in] loginID the login ID for OracleDB
+		@param[in] password the password for given login ID
+		@param[in] sessionMin the number of sessions opened when the pool is created
+		@param[in] sessionMax the maximal number of sessions
+		@param[in] sessionIncrement the number of sessions opened each time the pool grows
+		@param[in] getTimeout the time to wait for a free session in milli-seconds (WAITTIME_INIFINITE to wait until one is returned)
+		@param[in] idleTimeout the time after which idle sessions are closed in seconds (0 to keep them)
+		*/
+		void Create (const TCHAR *serviceName, const TCHAR *loginID, const TCHAR *password, unsigned int sessionMin = 1, unsigned int sessionMax = SESSION_POOL_MAX_SESSIONS, unsigned int sessionIncrement = 1, unsigned int getTimeout = WAITTIME_INIFINITE, unsigned int idleTimeout = 0);
+
+		/*!
+		Close all sessions and destroy the pool
+		*Every borrowed connection must be returned first
+		*/
+		void Destroy ();
+
+		/*!
+		Borrow a session of the pool
+		*Throws EC_TIMEOUT if no session is returned within the get timeout
+		@return the connection opened on the borrowed session
+		@remark the connection must be given back with Return
+		*/
+		Connection *Borrow ();
+
+		/*!
+		Give back a session borrowed with Borrow
+		@param[in] connection the connection to give back
+		*/
+		void Return (Connection *connection);
+
+		/*!
+		Return the current statistics of the pool
+		@return the statistics of the pool
+		*/
+		SessionPoolStatistics GetStatistics () const;
+
+		/*!
+		Return whether the pool is created
+		@return true if created, otherwise false.
+		*/
+		inline bool IsCreated () const
+		{
+			return m_isCreated;
+		}
+
+		/*!
+		Return the environment of the pool
+		@return the environment of the pool
+		*/
+		inline Environment &GetEnvironment () const
+		{
+			return *m_environment;
+		}
+
+	protected:
+		/*!
+		Default Destructor
+
+		Destroys the pool
+		*Use ReleaseObj instead
+		*/
+		virtual ~SessionPool ();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		*Class cannot be copied
+		@param pool the SessionPool object to copy
+		*/
+		SessionPool (const SessionPool& pool) :SmartObject(pool)
+		{
+			/* could not be copy-constructed */
+		}
+
+		/*!
+		Copy Operator
+
+		*Class cannot be copied
+		@param pool the SessionPool object to copy
+		*/
+		SessionPool& operator = (const SessionPool& pool)
+		{
+			return (*this); /* could not be copy-constructed */
+		}
+
+		/*!
+		Initialize the member variables
+		*/
+		void initialize ();
+
+		/*!
+		Get a session of the pool, waiting at most the get timeout
+		@param[in] errorHandle the error handle of the connection
+		@param[out] svcContextHandle the service context of the session
+		*/
+		void getSession (OCIError *errorHandle, OCISvcCtx **svcContextHandle);
+
+		/*!
+		Release a session got with getSession
+		@param[in] errorHandle the error handle of the connection
+		@param[in] svcContextHandle the service context of the session
+		@return the result of OCISessionRelease
+		*/
+		int releaseSession (OCIError *errorHandle, OCISvcCtx *svcContextHandle);
+
+		/*!
+		Return whether the last error of given handle means every session is busy
+		@param[in] errorHandle the error handle to check
+		@return true if every session is busy, otherwise false.
+		*/
+		static bool isPoolExhausted (OCIError *errorHandle);
+
+		/// the environment used
+		Environment		*m_environment;
+		/// pool handle
+		OCISPool		*m_poolHandle;
+		/// error handle
+		OCIError		*m_errorHandle;
+		/// the name of the pool (owned by the pool handle)
+		OraText			*m_poolName;
+		/// the length of the name of the pool in bytes
+		unsigned int	m_poolNameLength;
+
+		/// the maximal number of sessions
+		unsigned int	m_sessionMax;
+		/// the time to wait for a free session in milli-seconds
+		unsigned int	m_getTimeout;
+		/// flag whether the pool is created or not
+		bool			m_isCreated;
+
+		/// event signaled whenever a session is returned
+		epl::EventEx	m_returnEvent;
+		/// lock for the statistics
+		mutable epl::CriticalSectionEx	m_statLock;
+		/// the statistics counted by the library
+		SessionPoolStatistics	m_statistics;
+	};
+}
+
+#endif //__EP_SESSION_POOL_H__
@@ -39,6 +39,7 @@ An Interface for OracleDB SQL Statement.
 
 #include "epOraLib.h"
 #include "epOraDefines.h"
+#include "epOraError.h"
 #include <vector>
 #include <map>
 #include "oci.h"
@@ -48,43 +49,122 @@ namespace epol {
 	
 	class ResultSet;
 	class Connection;
+	class Parameter;
+	class AsyncOperation;
+	class AsyncReactor;
+
+	/// Structure for an error of one row of an array DML executed with EM_BATCH_ERRORS
+	struct BatchError
+	{
+		/// the index of the failed row (0 based)
+		unsigned int m_rowOffset;
+		/// the Oracle error code
+		int m_oraCode;
+		/// the Oracle error message
+		epl::EpTString m_message;
+	};
 
 	/*! 
 	@class Statement epStatement.h
 	@brief This is a class representing OracleDB SQL Statement 
 
 	Interface for the OracleDB SQL Statement.
+	*Each statement reports its errors into its own error handle, so statements of one connection
+	*can be used from different threads (one thread at a time per statement)
 	*/
 	class EP_ORACLELIB Statement:public epl::SmartObject
 	{
 		// friends
 		friend class Parameter;
 		friend class Connection;
+		friend class ExecuteOperation;
 
 	public:
 
 		/*!
 		Binds a named variable to the statement
 		*When type is set to DT_UNKNOWN type is taken from name's prefix
+		*If the variable is already bound with the same settings (e.g. a statement reused from the connection's statement cache),
+		*the existing parameter and its buffers are returned
 		@param[in] name the name of the variable
 		@param[in] type the Data type for the parameter
+		@param[in] arraySize the number of cells for array DML (see Execute)
+		@param[in] maxTextLength the maximal length of a text cell in characters (0 for default)
 		@return the parameter binded
 		*/
-		Parameter &Bind (const TCHAR *name,DataTypesEnum type = DT_UNKNOWN);
+		Parameter &Bind (const TCHAR *name,DataTypesEnum type = DT_UNKNOWN, unsigned int arraySize = 1, unsigned int maxTextLength = 0);
 
 		/*!
 		Executes the prepared statement with no output parameters
+		*With rowCount greater than 1 the statement runs once for each of the first rowCount cells
+		*of the bound parameters, in a single round trip
+		*With EM_BATCH_ERRORS failing rows do not stop the execution, they are reported by GetBatchErrors
+		*With EM_COMMIT_ON_SUCCESS the transaction is committed in the same round trip, if the execution succeeds
+		@param[in] rowCount the number of rows to execute (every parameter must have as many cells)
+		@param[in] executeMode the execute mode (EM_BATCH_ERRORS and EM_COMMIT_ON_SUCCESS may be combined)
+		*/
+		inline void Execute (unsigned int rowCount = 1, ExecuteModesEnum executeMode = EM_DEFAULT) 
+		{
+			executePrepared (rowCount, executeMode); 
+		}
+
+		/*!
+		Executes the prepared statement with no output parameters, returning the error of the call instead of throwing it
+		*For hot paths where errors are expected (a duplicate key, a lock timeout), the error text is not taken
+		*Misuse, such as parameters with fewer cells than rowCount, still throws
+		@param[in] rowCount the number of rows to execute (every parameter must have as many cells)
+		@param[in] executeMode the execute mode (EM_BATCH_ERRORS and EM_COMMIT_ON_SUCCESS may be combined)
+		@return the status of the execution
+		*/
+		Status TryExecute (unsigned int rowCount = 1, ExecuteModesEnum executeMode = EM_DEFAULT);
+
+		/*!
+		Start executing the prepared statement with no output parameters, and return at once
+		*The call is driven to its completion by given reactor; the connection should be opened in non-blocking mode
+		*and must not be used by any other call until the operation is done
+		@param[in] reactor the reactor to drive the execution
+		@param[in] rowCount the number of rows to execute (every parameter must have as many cells)
+		@param[in] executeMode the execute mode (EM_BATCH_ERRORS and EM_COMMIT_ON_SUCCESS may be combined)
+		@return the operation in progress (release it when done with it)
+		*/
+		AsyncOperation *ExecuteAsync (AsyncReactor &reactor, unsigned int rowCount = 1, ExecuteModesEnum executeMode = EM_DEFAULT);
+
+		/*!
+		Return the errors of the rows that failed in the last execution with EM_BATCH_ERRORS
+		@return the errors of the failed rows in row order
 		*/
-		inline void Execute () 
+		inline const std::vector <BatchError> &GetBatchErrors () const
 		{
-			executePrepared (); 
+			return m_batchErrors;
+		}
+
+		/*!
+		Return the number of rows processed by the last execution (OCI_ATTR_ROW_COUNT)
+		@return the number of rows processed by the last execution
+		*/
+		inline unsigned int GetRowCount () const
+		{
+			return m_rowCount;
 		}
 
 		/*!
 		Executes the prepared Select SQL statement and returns the result set
+		@param[in] fetchSize the number of rows to request on each fetch (0 to derive it from the connection's fetch memory budget)
+		@param[in] fetchMode the fetch mode (FM_PIPELINED fetches the next block in background, using twice the buffers,
+		*FM_BOUND_ROWS fetches nothing until rows are bound with ResultSet::BindRows)
 		@return the result set returned by executing the SQL statement
 		*/
-		ResultSet *Select();
+		ResultSet *Select(unsigned int fetchSize = 0, FetchModesEnum fetchMode = FM_DEFAULT);
+
+		/*!
+		Executes the prepared Select SQL statement and returns the result set, returning the error of the call instead of throwing it
+		*For hot paths where errors are expected (no rows, a lock timeout), the error text is not taken
+		@param[out] retResultSet the result set returned by executing the SQL statement (NULL if failed)
+		@param[in] fetchSize the number of rows to request on each fetch (0 to derive it from the connection's fetch memory budget)
+		@param[in] fetchMode the fetch mode (see Select)
+		@return the status of the execution and the first fetch
+		*/
+		Status TrySelect(ResultSet *&retResultSet, unsigned int fetchSize = 0, FetchModesEnum fetchMode = FM_DEFAULT);
 
 
 		/*!
@@ -105,6 +185,15 @@ namespace epol {
 			return m_isExecuted;
 		}
 
+		/*!
+		Return the SQL text of the statement
+		@return the SQL text of the statement
+		*/
+		const epl::EpTString &GetSQL() const
+		{
+			return m_sqlStmt;
+		}
+
 		/*!
 		Return the type of the statement
 		@return The statement type
@@ -185,10 +274,75 @@ namespace epol {
 		*/
 		void prepare (const TCHAR *sqlStmt);
 
+		/*!
+		Clear the bound values and the results left by the previous user of the cached statement
+		*The bindings themselves are kept for reuse
+		*/
+		void resetParameters ();
+
 		/*!
 		Execute the prepared statement
+		@param[in] rowCount the number of rows to execute
+		@param[in] executeMode the execute mode
+		*/
+		void executePrepared (unsigned int rowCount = 1, ExecuteModesEnum executeMode = EM_DEFAULT);
+
+		/*!
+		Execute the prepared statement without throwing the error of the call
+		@param[in] rowCount the number of rows to execute
+		@param[in] executeMode the execute mode
+		@return the OCI result of the execution
+		*/
+		int tryExecutePrepared (unsigned int rowCount, ExecuteModesEnum executeMode);
+
+		/*!
+		Execute the prepared Select statement and fetch the first block without throwing the error of the calls
+		*If the first fetch fails, the result set is returned too (its error handle holds the error)
+		@param[out] retResultSet the result set (NULL if the execution failed)
+		@param[in] fetchSize the number of rows to request on each fetch
+		@param[in] fetchMode the fetch mode
+		@param[out] retErrorHandle the error handle holding the error of the calls
+		@return the OCI result of the calls
+		*/
+		int trySelectPrepared (ResultSet *&retResultSet, unsigned int fetchSize, FetchModesEnum fetchMode, OCIError *&retErrorHandle);
+
+		/*!
+		Check the bound parameters and reset the results of the last execution
+		@param[in] rowCount the number of rows to execute
+		@param[in] executeMode the execute mode
+		@param[out] retIters the number of iterations of the call
+		@return the OCI execute mode
 		*/
-		void executePrepared ();
+		unsigned int beginExecute (unsigned int rowCount, ExecuteModesEnum executeMode, unsigned int &retIters);
+
+		/*!
+		Issue the execution call (again, while it returns OCI_STILL_EXECUTING)
+		@param[in] iters the number of iterations of the call
+		@param[in] mode the OCI execute mode
+		@return the OCI result of the call
+		*/
+		int executeStep (unsigned int iters, unsigned int mode);
+
+		/*!
+		Collect the results of the execution call
+		*Throws the error of the call
+		@param[in] result the OCI result of the call
+		@param[in] mode the OCI execute mode
+		*/
+		void endExecute (int result, unsigned int mode);
+
+		/*!
+		Collect the results of the execution call without throwing the error of the call
+		@param[in] result the OCI result of the call
+		@param[in] mode the OCI execute mode
+		@return the OCI result of the execution
+		*/
+		int completeExecute (int result, unsigned int mode);
+
+		/*!
+		Collect the errors of the failed rows after an execution with OCI_BATCH_ERRORS
+		*/
+		void collectBatchErrors ();
 
 
 
@@ -205,14 +359,23 @@ namespace epol {
 		Connection		*m_conn;	
 		/// the statement handle
 		OCIStmt			*m_stmtHandle;
+		/// error handle of the statement (and its parameters)
+		OCIError		*m_errorHandle;
 		/// the type of the statement
 		StatementTypesEnum	m_stmtType;
+		/// the SQL text of the statement
+		epl::EpTString	m_sqlStmt;
 
 		/// the flag whether the statement is prepared or not
 		bool			m_isPrepared;
 		/// the flag whether the statement is executed or not
 		bool			m_isExecuted;
 
+		/// the number of rows processed by the last execution
+		unsigned int	m_rowCount;
+		/// the errors of the rows failed in the last execution
+		std::vector <BatchError>	m_batchErrors;
+
 
 	};
 
@@ -38,12 +38,23 @@ An Interface for EP Oracle Library
 #define __EP_EPOL_H__
 
 #include "epOraDefines.h"
+#include "epAsyncExecutor.h"
+#include "epAsyncOperation.h"
+#include "epAsyncReactor.h"
 #include "epColumn.h"
+#include "epColumnView.h"
 #include "epConnection.h"
 #include "epDateTime.h"
+#include "epDirectPathLoader.h"
+#include "epEnvironment.h"
+#include "epNumberDecoder.h"
 #include "epOraError.h"
+#include "epParallelSelect.h"
 #include "epParameter.h"
+#include "epQueryJob.h"
 #include "epResultSet.h"
+#include "epRowMapping.h"
+#include "epSessionPool.h"
 #include "epStatement.h"
 
 #endif //__EP_EPOL_H__
\ No newline at end of file
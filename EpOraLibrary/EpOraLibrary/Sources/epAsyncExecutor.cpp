@@ -0,0 +1,249 @@
+/*! 
+OracleDB Asynchronous Executor for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epAsyncExecutor.h"
+#include "epConnection.h"
+#include "epEnvironment.h"
+#include "epSessionPool.h"
+#include "epOraError.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+QueryJobProcessor::QueryJobProcessor (AsyncExecutor *executor, Connection *conn) :BaseJobProcessor()
+{
+	EP_ASSERT (executor && conn);
+
+	m_executor = executor;
+	m_conn = conn;
+}
+
+
+void QueryJobProcessor::DoJob (epl::BaseWorkerThread *workerThread, epl::BaseJob* const data)
+{
+	QueryJob *job = static_cast <QueryJob *> (data);
+	job->run (*m_conn);
+	m_executor->jobDone (job);
+}
+
+
+AsyncExecutor::AsyncExecutor (Environment &environment, const TCHAR *serviceName, const TCHAR *loginID, const TCHAR *password, unsigned int workerCount) :m_idleEvent(true,true)
+{
+	EP_ASSERT (workerCount > 0);
+
+	initialize ();
+	try
+	{
+		for (unsigned int i = 0; i < workerCount; i++)
+			addWorker (EP_NEW Connection (environment, serviceName, loginID, password));
+	}
+	catch (...)
+	{
+		Stop ();
+		throw;
+	}
+}
+
+
+AsyncExecutor::AsyncExecutor (SessionPool &pool, unsigned int workerCount) :m_idleEvent(true,true)
+{
+	EP_ASSERT (workerCount > 0);
+
+	initialize ();
+	pool.RetainObj ();
+	m_pool = &pool;
+	try
+	{
+		for (unsigned int i = 0; i < workerCount; i++)
+			addWorker (pool.Borrow ());
+	}
+	catch (...)
+	{
+		Stop ();
+		throw;
+	}
+}
+
+
+AsyncExecutor::~AsyncExecutor ()
+{
+	Stop ();
+}
+
+
+void AsyncExecutor::initialize ()
+{
+	m_pool = NULL;
+	m_pendingCount = 0;
+	m_isStopped = false;
+}
+
+
+void AsyncExecutor::addWorker (Connection *conn)
+{
+	QueryJobProcessor *processor = NULL;
+	epl::WorkerThreadInfinite *worker = NULL;
+	try
+	{
+		processor = EP_NEW QueryJobProcessor (this, conn);
+		m_processors.push_back (processor);
+	}
+	catch (...)
+	{
+		if (processor)
+			processor->ReleaseObj ();
+		if (m_pool)
+			m_pool->Return (conn);
+		else
+			EP_DELETE conn;
+		throw;
+	}
+
+	worker = EP_NEW epl::WorkerThreadInfinite (epl::BaseWorkerThread::THREAD_LIFE_INFINITE);
+	worker->SetJobProcessor (processor);
+	try
+	{
+		m_workers.push_back (worker);
+	}
+	catch (...)
+	{
+		EP_DELETE worker;
+		throw;
+	}
+	if (!worker->Start ())
+		throw (OraError(__TFILE__, __LINE__));
+}
+
+
+void AsyncExecutor::Submit (QueryJob &job)
+{
+	if (m_isStopped)
+		throw (OraError(EC_INTERNAL, __TFILE__, __LINE__, _T("the executor is stopped")));
+
+	// the least busy worker
+	epl::WorkerThreadInfinite *worker = m_workers.front ();
+	for (std::vector <epl::WorkerThreadInfinite *>::iterator i = m_workers.begin (); i != m_workers.end (); ++i)
+	{
+		if ((*i)->GetJobCount () < worker->GetJobCount ())
+			worker = *i;
+	}
+
+	{
+		epl::LockObj lock (&m_lock);
+		m_pendingCount++;
+		m_idleEvent.ResetEvent ();
+	}
+	// released once the job is done or dropped
+	job.m_executor = this;
+	job.RetainObj ();
+	try
+	{
+		worker->Push (&job);
+	}
+	catch (...)
+	{
+		// never queued, so never done
+		job.m_executor = NULL;
+		jobDone (&job);
+		throw;
+	}
+}
+
+
+QueryJob *AsyncExecutor::Submit (const TCHAR *sqlStmt, epl::Priority priority, QueryCallback *callback)
+{
+	QueryJob *job = EP_NEW QueryJob (sqlStmt, priority, callback);
+	try
+	{
+		Submit (*job);
+	}
+	catch (...)
+	{
+		job->ReleaseObj ();
+		throw;
+	}
+	return (job);
+}
+
+
+bool AsyncExecutor::WaitAll (unsigned int waitTimeInMilliSec)
+{
+	return m_idleEvent.WaitForEvent (waitTimeInMilliSec);
+}
+
+
+unsigned int AsyncExecutor::GetPendingCount () const
+{
+	epl::LockObj lock (&m_lock);
+	return m_pendingCount;
+}
+
+
+void AsyncExecutor::jobDone (QueryJob *job)
+{
+	// retained on submission
+	job->ReleaseObj ();
+
+	epl::LockObj lock (&m_lock);
+	if (--m_pendingCount == 0)
+		m_idleEvent.SetEvent ();
+}
+
+
+void AsyncExecutor::Stop ()
+{
+	if (m_isStopped)
+		return;
+	m_isStopped = true;
+
+	WaitAll ();
+	for (std::vector <epl::WorkerThreadInfinite *>::iterator i = m_workers.begin (); i != m_workers.end (); ++i)
+	{
+		(*i)->TerminateWorker ();
+		EP_DELETE *i;
+	}
+	m_workers.clear ();
+
+	for (std::vector <QueryJobProcessor *>::iterator i = m_processors.begin (); i != m_processors.end (); ++i)
+	{
+		Connection *conn = (*i)->GetConnection ();
+		(*i)->ReleaseObj ();
+		if (m_pool)
+			m_pool->Return (conn);
+		else
+			EP_DELETE conn;
+	}
+	m_processors.clear ();
+
+	if (m_pool)
+		m_pool->ReleaseObj ();
+	m_pool = NULL;
+}
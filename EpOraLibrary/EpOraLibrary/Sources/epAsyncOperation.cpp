@@ -0,0 +1,156 @@
+/*! 
+OracleDB Asynchronous Operation for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epAsyncOperation.h"
+#include "epStatement.h"
+#include "epResultSet.h"
+#include "epOraError.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+AsyncOperation::AsyncOperation () :SmartObject(), m_doneEvent(false,true)
+{
+	m_rowCount = 0;
+	m_error = NULL;
+	m_isDone = false;
+}
+
+
+AsyncOperation::~AsyncOperation ()
+{
+	if (m_error)
+		EP_DELETE m_error;
+	m_error = NULL;
+}
+
+
+bool AsyncOperation::Wait (unsigned int waitTimeInMilliSec)
+{
+	if (!m_isDone && !m_doneEvent.WaitForEvent (waitTimeInMilliSec))
+		return (false);
+	if (m_error)
+		throw (OraError(*m_error));
+	return (true);
+}
+
+
+void AsyncOperation::markDone ()
+{
+	m_isDone = true;
+	m_doneEvent.SetEvent ();
+}
+
+
+void AsyncOperation::poll ()
+{
+	if (m_isDone)
+		return;
+
+	int result = step ();
+	if (result == OCI_STILL_EXECUTING)
+		return;
+
+	try
+	{
+		complete (result);
+	}
+	catch (OraError &error)
+	{
+		m_error = EP_NEW OraError(error);
+	}
+	catch (...)
+	{
+		m_error = EP_NEW OraError(EC_INTERNAL, __TFILE__, __LINE__);
+	}
+	markDone ();
+}
+
+
+ExecuteOperation::ExecuteOperation (Statement *stmt, unsigned int rowCount, ExecuteModesEnum executeMode) :AsyncOperation()
+{
+	EP_ASSERT (stmt);
+
+	// checks the bound parameters, so it could throw an exception
+	m_mode = stmt->beginExecute (rowCount, executeMode, m_iters);
+	m_stmt = stmt;
+	m_stmt->RetainObj ();
+}
+
+
+ExecuteOperation::~ExecuteOperation ()
+{
+	m_stmt->ReleaseObj ();
+}
+
+
+int ExecuteOperation::step ()
+{
+	return (m_stmt->executeStep (m_iters, m_mode));
+}
+
+
+void ExecuteOperation::complete (int result)
+{
+	m_stmt->endExecute (result, m_mode);
+	m_rowCount = m_stmt->GetRowCount ();
+}
+
+
+FetchOperation::FetchOperation (ResultSet *resultSet) :AsyncOperation()
+{
+	EP_ASSERT (resultSet);
+
+	m_resultSet = resultSet;
+	m_resultSet->RetainObj ();
+
+	// nothing left to fetch
+	if (m_resultSet->m_isEod)
+		markDone ();
+}
+
+
+FetchOperation::~FetchOperation ()
+{
+	m_resultSet->ReleaseObj ();
+}
+
+
+int FetchOperation::step ()
+{
+	return (m_resultSet->fetchAsyncStep ());
+}
+
+
+void FetchOperation::complete (int result)
+{
+	m_rowCount = m_resultSet->endFetch (result);
+}
@@ -0,0 +1,132 @@
+/*! 
+OracleDB Asynchronous Reactor for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epAsyncReactor.h"
+#include "epAsyncOperation.h"
+#include "epOraError.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+AsyncReactor::AsyncReactor (unsigned int pollInterval) :Thread(), m_wakeEvent(false,false)
+{
+	m_pollInterval = pollInterval;
+	m_isStopping = false;
+
+	if (!Start ())
+		throw (OraError(__TFILE__, __LINE__));
+}
+
+
+AsyncReactor::~AsyncReactor ()
+{
+	Stop ();
+}
+
+
+void AsyncReactor::Stop ()
+{
+	if (m_isStopping)
+		return;
+
+	m_isStopping = true;
+	m_wakeEvent.SetEvent ();
+	WaitFor ();
+}
+
+
+unsigned int AsyncReactor::GetQueuedCount () const
+{
+	epl::LockObj lock (&m_lock);
+	return static_cast <unsigned int> (m_submitted.size ());
+}
+
+
+void AsyncReactor::submit (AsyncOperation *operation)
+{
+	EP_ASSERT (operation);
+
+	if (m_isStopping)
+		throw (OraError(EC_INTERNAL, __TFILE__, __LINE__, _T("the reactor is stopped")));
+
+	operation->RetainObj ();
+	try
+	{
+		epl::LockObj lock (&m_lock);
+		m_submitted.push_back (operation);
+	}
+	catch (...) // STL exception, perhaps
+	{
+		operation->ReleaseObj ();
+		throw;
+	}
+	m_wakeEvent.SetEvent ();
+}
+
+
+void AsyncReactor::execute ()
+{
+	std::vector <AsyncOperation *> pending;
+
+	for (;;)
+	{
+		{
+			epl::LockObj lock (&m_lock);
+			pending.insert (pending.end (), m_submitted.begin (), m_submitted.end ());
+			m_submitted.clear ();
+		}
+
+		if (pending.empty ())
+		{
+			if (m_isStopping)
+				break;
+			m_wakeEvent.WaitForEvent ();
+			continue;
+		}
+
+		// re-issue every call still executing once
+		std::vector <AsyncOperation *>::iterator i = pending.begin ();
+		while (i != pending.end ())
+		{
+			(*i)->poll ();
+			if ((*i)->IsDone ())
+			{
+				(*i)->ReleaseObj ();
+				i = pending.erase (i);
+			}
+			else
+				++i;
+		}
+
+		if (!pending.empty ())
+			m_wakeEvent.WaitForEvent (m_pollInterval);
+	}
+}
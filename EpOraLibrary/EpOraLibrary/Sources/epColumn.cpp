@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "epOraError.h"
 #include "epResultSet.h"
 #include "epConnection.h"
+#include "epNumberDecoder.h"
 
 #if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 #define new DEBUG_NEW
@@ -40,7 +41,20 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epol;
 
-Column::Column (ResultSet *rs, const TCHAR *name, unsigned short ociDataType, unsigned int maxDataSize, unsigned int fetchSize) : SmartObject()
+/// the largest double below 2^63
+#define MAX_INT64_DOUBLE 9223372036854774784.0
+
+/*!
+Return whether given double can be truncated to 64-bit integer
+@param[in] value the value to check
+@return true if the truncated value fits in 64-bit integer
+*/
+static inline bool fitsInt64 (double value)
+{
+	return (value >= -MAX_INT64_DOUBLE && value <= MAX_INT64_DOUBLE);
+}
+
+Column::Column (ResultSet *rs, const TCHAR *name, unsigned short ociDataType, unsigned int maxDataSize, short precision, signed char scale) : SmartObject()
 {
 	EP_ASSERT (rs && name);
 
@@ -51,10 +65,38 @@ Column::Column (ResultSet *rs, const TCHAR *name, unsigned short ociDataType, un
 
 	switch (ociDataType)
 	{
+	case	SQLT_NUM:	// numeric
+		if (scale == 0 && precision > 0 && precision <= MAX_NATIVE_INT_PRECISION)
+		{
+			// NUMBER(p) with p <= 18 always fits in 64-bit integer
+			m_ociType = SQLT_INT;
+			m_colType = DT_NUMBER;
+			m_size = sizeof (__int64);
+			break;
+		}
+		if (scale == -127 && precision != 0)
+		{
+			// FLOAT(b)
+			m_ociType = SQLT_BDOUBLE;
+			m_colType = DT_NUMBER;
+			m_size = sizeof (double);
+			break;
+		}
+		m_ociType = SQLT_VNU;
+		m_colType = DT_NUMBER;
+		m_size = sizeof (OCINumber);
+		break;
+
+	case	SQLT_IBFLOAT:	// binary float
+	case	SQLT_IBDOUBLE:	// binary double
+		m_ociType = SQLT_BDOUBLE;
+		m_colType = DT_NUMBER;
+		m_size = sizeof (double);
+		break;
+
 	case	SQLT_INT:	// integer
 	case	SQLT_UIN:	// unsigned int
 
-	case	SQLT_NUM:	// numeric
 	case	SQLT_FLT:	// float
 	case	SQLT_VNU:	// numeric with length
 	case	SQLT_PDN:	// packed decimal
@@ -86,23 +128,7 @@ Column::Column (ResultSet *rs, const TCHAR *name, unsigned short ociDataType, un
 		throw (OraError(EC_UNSUP_ORA_TYPE, __TFILE__, __LINE__, name));
 	}
 
-	m_indicators = EP_NEW short [fetchSize];
-
-	if (m_colType == DT_TEXT)
-		m_dataLengths = EP_NEW unsigned short [fetchSize];
-	else
-		m_dataLengths = NULL;
-
-	m_fetchBuffer = EP_NEW char [m_size * fetchSize];
-
 	m_defineHandle = NULL;
-
-	if (!m_indicators || !m_fetchBuffer)
-	{
-		cleanUp (); 
-		throw (OraError(EC_NO_MEMORY, __TFILE__, __LINE__));
-	}
-
 	m_resultSet = rs;
 }
 
@@ -121,6 +147,13 @@ void Column::initialize ()
 	m_indicators = NULL;
 	m_dataLengths = NULL;
 	m_fetchBuffer = NULL;
+	for (unsigned int set=0; set<FETCH_BUFFER_SETS; set++)
+	{
+		m_indicatorSets[set] = NULL;
+		m_dataLengthSets[set] = NULL;
+		m_fetchBufferSets[set] = NULL;
+	}
+	m_bufferSets = 0;
 	m_defineHandle = NULL;
 	m_resultSet = NULL;
 }
@@ -128,25 +161,79 @@ void Column::initialize ()
 
 void Column::cleanUp ()
 {
-	if (m_indicators) 
+	// the buffers live in the arena of the result set
+	for (unsigned int set=0; set<FETCH_BUFFER_SETS; set++)
 	{
-		EP_DELETE [] m_indicators; 
+		m_indicatorSets[set] = NULL;
+		m_dataLengthSets[set] = NULL;
+		m_fetchBufferSets[set] = NULL;
 	}
+	m_bufferSets = 0;
 	m_indicators = NULL;
-	if (m_dataLengths) 
-		EP_DELETE [] m_dataLengths;
 	m_dataLengths = NULL;
-	if (m_fetchBuffer) 
-		EP_DELETE [] m_fetchBuffer;
 	m_fetchBuffer = NULL;
 }
 
 
+unsigned int Column::getRowBytes () const
+{
+	unsigned int rowBytes = m_size + sizeof (short);
+	if (m_colType == DT_TEXT)
+		rowBytes += sizeof (unsigned short);
+	return (rowBytes);
+}
+
+
+size_t Column::getArenaBytes (unsigned int fetchSize, unsigned int bufferSets) const
+{
+	size_t setBytes = ALIGN_TO_CACHE_LINE (sizeof (short) * fetchSize) + ALIGN_TO_CACHE_LINE ((size_t) m_size * fetchSize);
+	if (m_colType == DT_TEXT)
+		setBytes += ALIGN_TO_CACHE_LINE (sizeof (unsigned short) * fetchSize);
+	return (setBytes * bufferSets);
+}
+
+
+void Column::allocate (unsigned int fetchSize, unsigned int bufferSets, char *arena)
+{
+	EP_ASSERT (fetchSize > 0 && bufferSets > 0 && bufferSets <= FETCH_BUFFER_SETS && m_bufferSets == 0);
+	EP_ASSERT (arena);
+
+	for (unsigned int set=0; set<bufferSets; set++)
+	{
+		m_indicatorSets[set] = reinterpret_cast <short *> (arena);
+		arena += ALIGN_TO_CACHE_LINE (sizeof (short) * fetchSize);
+
+		if (m_colType == DT_TEXT)
+		{
+			m_dataLengthSets[set] = reinterpret_cast <unsigned short *> (arena);
+			arena += ALIGN_TO_CACHE_LINE (sizeof (unsigned short) * fetchSize);
+		}
+		else
+			m_dataLengthSets[set] = NULL;
+
+		m_fetchBufferSets[set] = arena;
+		arena += ALIGN_TO_CACHE_LINE ((size_t) m_size * fetchSize);
+	}
+	m_bufferSets = bufferSets;
+	selectBufferSet (0);
+}
+
+
+void Column::selectBufferSet (unsigned int bufferSet)
+{
+	EP_ASSERT (bufferSet < m_bufferSets);
+
+	m_indicators = m_indicatorSets[bufferSet];
+	m_dataLengths = m_dataLengthSets[bufferSet];
+	m_fetchBuffer = m_fetchBufferSets[bufferSet];
+}
+
+
 bool Column::IsNull () const
 {
 	EP_ASSERT (m_resultSet);
 
-	unsigned short	rowNo = static_cast <unsigned short> (m_resultSet->m_currentRow % m_resultSet->m_fetchCount);
+	unsigned int	rowNo = m_resultSet->columnSlot ();
 	return (m_indicators [rowNo] == -1);
 }
 
@@ -155,30 +242,74 @@ epl::EpTString Column::ToString () const
 {
 	EP_ASSERT (m_resultSet);
 
-	unsigned short	row_no = static_cast <unsigned short> (m_resultSet->m_currentRow % m_resultSet->m_fetchCount);
-	if (m_colType == DT_TEXT &&	m_indicators [row_no] != -1)
+	unsigned int length;
+	const TCHAR *text = GetText (&length);
+	return epl::EpTString(text, length);
+}
+
+
+const TCHAR *Column::GetText (unsigned int *retLength) const
+{
+	EP_ASSERT (m_resultSet);
+
+	unsigned int	rowNo = m_resultSet->columnSlot ();
+	if (m_colType == DT_TEXT &&	m_indicators [rowNo] != -1)
 	{
-		return epl::EpTString(reinterpret_cast<TCHAR*>(m_fetchBuffer + m_size * row_no));
+		const TCHAR *text = reinterpret_cast<TCHAR*>(m_fetchBuffer + m_size * rowNo);
+		if (retLength)
+		{
+			unsigned int length = m_dataLengths [rowNo] / sizeof (TCHAR);
+			if (length > 0 && text [length - 1] == _T('\0'))
+				length--;
+			*retLength = length;
+		}
+		return (text);
 	}
 	else
 		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
 }
 
 
+unsigned int Column::CopyTo (TCHAR *buffer, unsigned int capacity) const
+{
+	EP_ASSERT (buffer && capacity > 0);
+
+	unsigned int length;
+	const TCHAR *text = GetText (&length);
+	if (length > capacity - 1)
+		length = capacity - 1;
+	memcpy (buffer, text, length * sizeof (TCHAR));
+	buffer [length] = _T('\0');
+	return (length);
+}
+
+
 double Column::ToDouble () const
 {
 	EP_ASSERT (m_resultSet);
 
-	unsigned short	rowNo = static_cast <unsigned short> (m_resultSet->m_currentRow % m_resultSet->m_fetchCount);
+	unsigned int	rowNo = m_resultSet->columnSlot ();
 	if (m_colType == DT_NUMBER &&
 		m_indicators [rowNo] != -1)
 	{
+		switch (m_ociType)
+		{
+		case	SQLT_INT:
+			return (static_cast <double> (reinterpret_cast <__int64 *> (m_fetchBuffer) [rowNo]));
+		case	SQLT_BDOUBLE:
+			return (reinterpret_cast <double *> (m_fetchBuffer) [rowNo]);
+		}
+
+		const OCINumber *number = reinterpret_cast <OCINumber *> (m_fetchBuffer) + rowNo;
 		double	value;
-		int result = ::OCINumberToReal (m_resultSet->m_conn->m_errorHandle,reinterpret_cast <OCINumber *> (m_fetchBuffer) + rowNo, sizeof (double), &value);
+		if (NumberDecoder::ToDouble (number, value))
+			return (value);
+
+		int result = ::OCINumberToReal (m_resultSet->m_errorHandle, number, sizeof (double), &value);
 		if (result == OCI_SUCCESS)
 			return (value);
 		else
-			throw (OraError(result, m_resultSet->m_conn->m_errorHandle, __TFILE__, __LINE__));
+			throw (OraError(result, m_resultSet->m_errorHandle, __TFILE__, __LINE__));
 	}
 	else
 		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
@@ -190,27 +321,184 @@ long
 {
 	EP_ASSERT (m_resultSet);
 
-	unsigned short	rowNo = static_cast <unsigned short> (m_resultSet->m_currentRow % m_resultSet->m_fetchCount);
+	unsigned int	rowNo = m_resultSet->columnSlot ();
 	if (m_colType == DT_NUMBER &&
 		m_indicators [rowNo] != -1)
 	{
+		if (m_ociType != SQLT_VNU)
+		{
+			__int64 value = ToInt64 ();
+			if (static_cast <__int64> (static_cast <long> (value)) != value)
+				throw (OraError(EC_BAD_TRANSFORM, __TFILE__, __LINE__));
+			return (static_cast <long> (value));
+		}
+
+		const OCINumber *number = reinterpret_cast <OCINumber *> (m_fetchBuffer) + rowNo;
+		__int64 decoded;
+		if (NumberDecoder::ToInt64 (number, decoded) && static_cast <__int64> (static_cast <long> (decoded)) == decoded)
+			return (static_cast <long> (decoded));
+
 		long value;
-		sword result = OCINumberToInt (m_resultSet->m_conn->m_errorHandle, reinterpret_cast <OCINumber *> (m_fetchBuffer) + rowNo, sizeof (long), OCI_NUMBER_SIGNED, &value);
+		sword result = OCINumberToInt (m_resultSet->m_errorHandle, number, sizeof (long), OCI_NUMBER_SIGNED, &value);
 		if (result == OCI_SUCCESS)
 			return (value);
 		else
-			throw (OraError(result, m_resultSet->m_conn->m_errorHandle, __TFILE__, __LINE__));
+			throw (OraError(result, m_resultSet->m_errorHandle, __TFILE__, __LINE__));
 	}
 	else
 		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
 }
 
 
+__int64 Column::ToInt64 () const
+{
+	EP_ASSERT (m_resultSet);
+
+	unsigned int	rowNo = m_resultSet->columnSlot ();
+	if (m_colType == DT_NUMBER &&
+		m_indicators [rowNo] != -1)
+	{
+		switch (m_ociType)
+		{
+		case	SQLT_INT:
+			return (reinterpret_cast <__int64 *> (m_fetchBuffer) [rowNo]);
+		case	SQLT_BDOUBLE:
+			{
+				double value = reinterpret_cast <double *> (m_fetchBuffer) [rowNo];
+				if (!fitsInt64 (value))
+					throw (OraError(EC_BAD_TRANSFORM, __TFILE__, __LINE__));
+				return (static_cast <__int64> (value));
+			}
+		}
+
+		const OCINumber *number = reinterpret_cast <OCINumber *> (m_fetchBuffer) + rowNo;
+		__int64 value;
+		if (NumberDecoder::ToInt64 (number, value))
+			return (value);
+
+		sword result = OCINumberToInt (m_resultSet->m_errorHandle, number, sizeof (__int64), OCI_NUMBER_SIGNED, &value);
+		if (result == OCI_SUCCESS)
+			return (value);
+		else
+			throw (OraError(result, m_resultSet->m_errorHandle, __TFILE__, __LINE__));
+	}
+	else
+		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+}
+
+
+unsigned int Column::ToInt64Array (__int64 *retValues) const
+{
+	EP_ASSERT (m_resultSet);
+
+	if (m_colType != DT_NUMBER)
+		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+	if (m_resultSet->m_batchSize == 0)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__, _T("no current batch")));
+
+	unsigned int batchStart = m_resultSet->m_batchStart;
+	unsigned int batchSize = m_resultSet->m_batchSize;
+	const short *indicators = m_indicators + batchStart;
+	unsigned int i;
+
+	switch (m_ociType)
+	{
+	case	SQLT_INT:
+		{
+			const __int64 *values = reinterpret_cast <__int64 *> (m_fetchBuffer) + batchStart;
+			for (i = 0; i < batchSize; i++)
+				retValues [i] = (indicators [i] == ORADATA_NULL) ? 0 : values [i];
+		}
+		break;
+	case	SQLT_BDOUBLE:
+		{
+			const double *values = reinterpret_cast <double *> (m_fetchBuffer) + batchStart;
+			for (i = 0; i < batchSize; i++)
+			{
+				if (indicators [i] == ORADATA_NULL)
+				{
+					retValues [i] = 0;
+					continue;
+				}
+				if (!fitsInt64 (values [i]))
+					throw (OraError(EC_BAD_TRANSFORM, __TFILE__, __LINE__));
+				retValues [i] = static_cast <__int64> (values [i]);
+			}
+		}
+		break;
+	default:
+		NumberDecoder::ToInt64Array (m_resultSet->m_errorHandle, reinterpret_cast <OCINumber *> (m_fetchBuffer) + batchStart, indicators, batchSize, retValues);
+		break;
+	}
+	return (batchSize);
+}
+
+
+unsigned int Column::ToDoubleArray (double *retValues) const
+{
+	EP_ASSERT (m_resultSet);
+
+	if (m_colType != DT_NUMBER)
+		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+	if (m_resultSet->m_batchSize == 0)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__, _T("no current batch")));
+
+	unsigned int batchStart = m_resultSet->m_batchStart;
+	unsigned int batchSize = m_resultSet->m_batchSize;
+	const short *indicators = m_indicators + batchStart;
+	unsigned int i;
+
+	switch (m_ociType)
+	{
+	case	SQLT_INT:
+		{
+			const __int64 *values = reinterpret_cast <__int64 *> (m_fetchBuffer) + batchStart;
+			for (i = 0; i < batchSize; i++)
+				retValues [i] = (indicators [i] == ORADATA_NULL) ? 0 : static_cast <double> (values [i]);
+		}
+		break;
+	case	SQLT_BDOUBLE:
+		{
+			const double *values = reinterpret_cast <double *> (m_fetchBuffer) + batchStart;
+			for (i = 0; i < batchSize; i++)
+				retValues [i] = (indicators [i] == ORADATA_NULL) ? 0 : values [i];
+		}
+		break;
+	default:
+		NumberDecoder::ToDoubleArray (m_resultSet->m_errorHandle, reinterpret_cast <OCINumber *> (m_fetchBuffer) + batchStart, indicators, batchSize, retValues);
+		break;
+	}
+	return (batchSize);
+}
+
+
+ColumnView Column::GetView () const
+{
+	EP_ASSERT (m_resultSet);
+
+	if (m_resultSet->m_batchSize == 0)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__, _T("no current batch")));
+
+	ColumnView view;
+	unsigned int batchStart = m_resultSet->m_batchStart;
+
+	view.m_colType = m_colType;
+	view.m_ociType = m_ociType;
+	view.m_stride = m_size;
+	view.m_rowCount = m_resultSet->m_batchSize;
+	view.m_data = m_fetchBuffer + m_size * batchStart;
+	view.m_indicators = m_indicators + batchStart;
+	if (m_dataLengths)
+		view.m_dataLengths = m_dataLengths + batchStart;
+	return (view);
+}
+
+
 DateTime Column::ToDateTime () const
 {
 	EP_ASSERT (m_resultSet);
 
-	unsigned short	rowNo = static_cast <unsigned short> (m_resultSet->m_currentRow % m_resultSet->m_fetchCount);
+	unsigned int	rowNo = m_resultSet->columnSlot ();
 	if (m_colType == DT_DATE &&
 		m_indicators [rowNo] != -1)
 		return (DateTime (*(reinterpret_cast <OCIDate *> (m_fetchBuffer) + rowNo)));
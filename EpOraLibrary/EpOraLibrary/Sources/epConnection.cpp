@@ -60,6 +60,36 @@ Connection::Connection (const TCHAR *serviceName, const TCHAR *loginID,const TCH
 }
 
 
+Connection::Connection (Environment &environment, const TCHAR *serviceName, const TCHAR *loginID,const TCHAR *password, bool nonBlockingMode)
+{
+	initialize ();
+	try
+	{
+		Open (environment, serviceName,	loginID, password, nonBlockingMode);
+	}
+	catch (...)
+	{
+		Close ();
+		throw;
+	}
+}
+
+
+Connection::Connection (SessionPool &pool)
+{
+	initialize ();
+	try
+	{
+		Open (pool);
+	}
+	catch (...)
+	{
+		Close ();
+		throw;
+	}
+}
+
+
 Connection::~Connection ()
 {
 	cleanUp (); 
@@ -68,6 +98,8 @@ Connection::~Connection ()
 
 void Connection::initialize ()
 {
+	m_environment = NULL;
+	m_pool = NULL;
 	m_envHandle = NULL;
 	m_serverHandle = NULL;
 	m_errorHandle = NULL;
@@ -76,28 +108,44 @@ void Connection::initialize ()
 
 	m_isOpened = false;
 	m_isBlocking = false;
+
+	m_fetchMemoryBudget = FETCH_MEMORY_BUDGET;
+	m_statementCacheSize = STATEMENT_CACHE_SIZE;
+	m_arenaPoolBytes = 0;
+	m_arenaPoolSize = FETCH_BUFFER_POOL_SIZE;
 }
 
 
 void Connection::Open (const TCHAR *serviceName,const TCHAR *loginID,const TCHAR *password,unsigned long envMode, bool nonBlockingMode)
+{
+	// a private environment, released when the connection is closed
+	Environment *environment = EP_NEW Environment (envMode);
+	try
+	{
+		Open (*environment, serviceName, loginID, password, nonBlockingMode);
+	}
+	catch (...)
+	{
+		environment->ReleaseObj ();
+		throw;
+	}
+	environment->ReleaseObj ();
+}
+
+
+void Connection::Open (Environment &environment, const TCHAR *serviceName,const TCHAR *loginID,const TCHAR *password, bool nonBlockingMode)
 {
 	EP_ASSERT (serviceName);
-	EP_ASSERT (!m_isOpened);
+	EP_ASSERT (!m_isOpened && !m_environment);
 
 	int	result;
 
-	// allocate an environment handle
-#if defined(_UNICODE) || defined(UNICODE)
-	result = OCIEnvNlsCreate(&m_envHandle,envMode,NULL,NULL,NULL,0,NULL,NULL,OCI_UTF16ID,OCI_UTF16ID);
-#else //defined(_UNICODE) || defined(UNICODE)
-	result = OCIEnvCreate ( &m_envHandle, envMode, NULL, NULL, NULL, NULL, 0, NULL);
-#endif //defined(_UNICODE) || defined(UNICODE)
+	environment.RetainObj ();
+	m_environment = &environment;
+	m_envHandle = environment.GetHandle ();
 
 	// allocate a server handle
-	if (result == OCI_SUCCESS)
-		result = OCIHandleAlloc (m_envHandle, (void **) &m_serverHandle, OCI_HTYPE_SERVER, 0,NULL);	
-	else
-		throw (OraError(EC_ENV_CREATE_FAILED, __TFILE__, __LINE__));
+	result = OCIHandleAlloc (m_envHandle, (void **) &m_serverHandle, OCI_HTYPE_SERVER, 0,NULL);	
 
 	// allocate an error handle
 	if (result == OCI_SUCCESS)
@@ -169,10 +217,59 @@ void Connection::Open (const TCHAR *serviceName,const TCHAR *loginID,const TCHAR
 }
 
 
+void Connection::Open (SessionPool &pool)
+{
+	EP_ASSERT (!m_isOpened && !m_environment && !m_pool);
+
+	int	result;
+
+	// the pool keeps its environment alive
+	pool.RetainObj ();
+	m_pool = &pool;
+	m_envHandle = pool.GetEnvironment ().GetHandle ();
+
+	// allocate an error handle
+	result = OCIHandleAlloc (m_envHandle, (void **) &m_errorHandle, OCI_HTYPE_ERROR, 0, NULL);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_envHandle, __TFILE__, __LINE__));
+
+	// borrow a session, already logged on
+	pool.getSession (m_errorHandle, &m_svcContextHandle);
+
+	m_isOpened = true;
+	m_isBlocking = true;
+}
+
+
 void Connection::Close ()
 {
 	int	result;
 
+	epl::LockObj lock (&m_lock);
+
+	// the statement handles must go before the session
+	trimStatementCache (0);
+	trimArenaPool (0);
+
+	if (m_pool != NULL)
+	{
+		// give the session back to the pool
+		if (m_svcContextHandle != NULL)
+			m_pool->releaseSession (m_errorHandle, m_svcContextHandle);
+		m_svcContextHandle = NULL;
+
+		if (m_errorHandle != NULL)
+			OCIHandleFree (m_errorHandle, OCI_HTYPE_ERROR);
+		m_errorHandle = NULL;
+
+		m_pool->ReleaseObj ();
+		m_pool = NULL;
+		m_envHandle = NULL;
+		m_isOpened = false;
+		m_isBlocking = false;
+		return;
+	}
+
 	if (m_serverHandle != NULL)
 	{
 		unsigned char attrValue;
@@ -218,12 +315,12 @@ void Connection::Close ()
 	}
 
 
-	if (result == OCI_SUCCESS && m_envHandle != NULL)
+	if (result == OCI_SUCCESS && m_environment != NULL)
 	{
 		m_serverHandle = NULL;
-		result = OCIHandleFree (m_envHandle, OCI_HTYPE_ENV);
-		if (result == OCI_SUCCESS)
-			m_envHandle = NULL;
+		m_environment->ReleaseObj ();
+		m_environment = NULL;
+		m_envHandle = NULL;
 	}
 
 	if (result == OCI_SUCCESS)
@@ -237,26 +334,244 @@ void Connection::Close ()
 void Connection::Execute (const TCHAR *sqlStmt)
 {
 	EP_ASSERT (sqlStmt);
-	Statement st (*this, sqlStmt);
-	st.executePrepared ();
+	Statement *statement = Prepare (sqlStmt);
+	try
+	{
+		statement->executePrepared ();
+	}
+	catch (...)
+	{
+		statement->ReleaseObj();
+		throw;
+	}
+	statement->ReleaseObj();
+}
+
+
+Status Connection::TryExecute (const TCHAR *sqlStmt)
+{
+	EP_ASSERT (sqlStmt);
+	Statement *statement = Prepare (sqlStmt);
+	Status status;
+	try
+	{
+		status = statement->TryExecute ();
+	}
+	catch (...)
+	{
+		statement->ReleaseObj();
+		throw;
+	}
+	statement->ReleaseObj();
+	return (status);
+}
+
+
+void Connection::Commit ()
+{
+	EP_ASSERT (m_isOpened);
+	epl::LockObj lock (&m_lock);
+	int result = endTransaction (true);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
+}
+
+
+void Connection::Rollback ()
+{
+	EP_ASSERT (m_isOpened);
+	epl::LockObj lock (&m_lock);
+	int result = endTransaction (false);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
+}
+
+
+Status Connection::TryCommit ()
+{
+	EP_ASSERT (m_isOpened);
+	epl::LockObj lock (&m_lock);
+	int result = endTransaction (true);
+	return (Status(result, m_errorHandle));
+}
+
+
+Status Connection::TryRollback ()
+{
+	EP_ASSERT (m_isOpened);
+	epl::LockObj lock (&m_lock);
+	int result = endTransaction (false);
+	return (Status(result, m_errorHandle));
+}
+
+
+int Connection::endTransaction (bool isCommit)
+{
+	int result;
+	// a non-blocking connection returns OCI_STILL_EXECUTING until the call completes
+	while (true)
+	{
+		result = isCommit ? OCITransCommit (m_svcContextHandle, m_errorHandle, OCI_DEFAULT) : OCITransRollback (m_svcContextHandle, m_errorHandle, OCI_DEFAULT);
+		if (result != OCI_STILL_EXECUTING)
+			break;
+		Sleep (ASYNC_REACTOR_POLL_INTERVAL);
+	}
+	return (result);
 }
 
 
 Statement* Connection::Prepare (const TCHAR *sqlStmt)	
 {
 	EP_ASSERT (sqlStmt);
-	return (EP_NEW Statement (*this, sqlStmt));
+	Statement *statement = findCachedStatement (sqlStmt);
+	if (statement)
+		return (statement);
+
+	statement = EP_NEW Statement (*this, sqlStmt);
+	try
+	{
+		cacheStatement (statement);
+	}
+	catch (...) // STL exception, perhaps
+	{
+		statement->ReleaseObj();
+		throw;
+	}
+	return (statement);
+}
+
+
+void Connection::SetStatementCacheSize (unsigned int size)
+{
+	epl::LockObj lock (&m_lock);
+	m_statementCacheSize = size;
+	trimStatementCache (size);
+}
+
+
+Statement *Connection::findCachedStatement (const TCHAR *sqlStmt)
+{
+	epl::LockObj lock (&m_lock);
+	StatementCache::iterator i = m_statementCache.find (epl::EpTString(sqlStmt));
+	if (i == m_statementCache.end ())
+		return (NULL);
+
+	// only the cache holds an idle statement
+	Statement *statement = *(i->second);
+	if (statement->GetReferenceCount () > 1)
+		return (NULL);
+
+	m_cachedStatements.splice (m_cachedStatements.begin (), m_cachedStatements, i->second);
+	// the values of the previous user must not leak into the next execution
+	statement->resetParameters ();
+	statement->RetainObj ();
+	return (statement);
+}
+
+
+void Connection::cacheStatement (Statement *statement)
+{
+	epl::LockObj lock (&m_lock);
+
+	// a statement in use keeps its place, the new one is not cached
+	if (m_statementCacheSize == 0 || m_statementCache.find (statement->GetSQL ()) != m_statementCache.end ())
+		return;
+
+	m_cachedStatements.push_front (statement);
+	try
+	{
+		m_statementCache [statement->GetSQL ()] = m_cachedStatements.begin ();
+	}
+	catch (...)
+	{
+		m_cachedStatements.pop_front ();
+		throw;
+	}
+	statement->RetainObj ();
+	trimStatementCache (m_statementCacheSize);
+}
+
+
+void Connection::trimStatementCache (unsigned int size)
+{
+	while (m_cachedStatements.size () > size)
+	{
+		Statement *statement = m_cachedStatements.back ();
+		m_statementCache.erase (statement->GetSQL ());
+		m_cachedStatements.pop_back ();
+		statement->ReleaseObj ();
+	}
+}
+
+
+void Connection::SetFetchBufferPoolSize (unsigned int size)
+{
+	epl::LockObj lock (&m_lock);
+	m_arenaPoolSize = size;
+	trimArenaPool (size);
+}
+
+
+char *Connection::borrowArena (size_t bytes)
+{
+	epl::LockObj lock (&m_lock);
+	ArenaPool::iterator i = m_arenaPool.find (bytes);
+	if (i == m_arenaPool.end ())
+		return (NULL);
+
+	char *arena = i->second;
+	m_arenaPool.erase (i);
+	m_arenaPoolBytes -= bytes;
+	return (arena);
+}
+
+
+void Connection::returnArena (char *arena, size_t bytes)
+{
+	EP_ASSERT (arena);
+
+	{
+		epl::LockObj lock (&m_lock);
+		if (m_arenaPool.size () < m_arenaPoolSize && m_arenaPoolBytes + bytes <= FETCH_BUFFER_POOL_MAX_BYTES)
+		{
+			try
+			{
+				m_arenaPool.insert (ArenaPool::value_type (bytes, arena));
+				m_arenaPoolBytes += bytes;
+				return;
+			}
+			catch (...)
+			{
+				// not kept, freed below
+			}
+		}
+	}
+	EP_DELETE [] arena;
+}
+
+
+void Connection::trimArenaPool (unsigned int size)
+{
+	// the largest arenas go first
+	while (m_arenaPool.size () > size)
+	{
+		ArenaPool::iterator i = m_arenaPool.end ();
+		--i;
+		m_arenaPoolBytes -= i->first;
+		EP_DELETE [] i->second;
+		m_arenaPool.erase (i);
+	}
 }
 
 
-ResultSet* Connection::Select (const TCHAR *selectStmt)
+ResultSet* Connection::Select (const TCHAR *selectStmt, unsigned int fetchSize, FetchModesEnum fetchMode)
 {
 	EP_ASSERT (selectStmt);
 
 	Statement	*statement = Prepare (selectStmt);
 	try
 	{
-		ResultSet	*result = statement->Select ();
+		ResultSet	*result = statement->Select (fetchSize, fetchMode);
 		result->attachStatement (statement);
 		return (result);
 	}
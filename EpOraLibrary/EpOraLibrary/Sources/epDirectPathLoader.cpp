@@ -0,0 +1,329 @@
+/*! 
+OracleDB Direct Path Loader for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epDirectPathLoader.h"
+#include "epConnection.h"
+#include "epOraError.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+DirectPathLoader::DirectPathLoader (Connection &useConnection, const TCHAR *tableName, const TCHAR *schemaName, unsigned int streamBufferSize)	// = NULL, = DIRPATH_STREAM_BUFFER_SIZE
+{
+	EP_ASSERT (tableName && streamBufferSize > 0);
+
+	initialize ();
+	m_conn = &useConnection;
+	m_tableName = tableName;
+	if (schemaName)
+		m_schemaName = schemaName;
+	m_streamBufferSize = streamBufferSize;
+}
+
+
+DirectPathLoader::~DirectPathLoader ()
+{
+	cleanUp ();
+}
+
+
+void DirectPathLoader::initialize ()
+{
+	m_conn = NULL;
+	m_streamBufferSize = 0;
+	m_errorHandle = NULL;
+	m_ctxHandle = NULL;
+	m_columnArrayHandle = NULL;
+	m_streamHandle = NULL;
+	m_columnArrayRows = 0;
+	m_rowsLoaded = 0;
+	m_isPrepared = false;
+}
+
+
+void DirectPathLoader::cleanUp ()
+{
+	if (m_isPrepared)
+		OCIDirPathAbort (m_ctxHandle, m_errorHandle);
+	m_isPrepared = false;
+
+	if (m_streamHandle)
+		OCIHandleFree (m_streamHandle, OCI_HTYPE_DIRPATH_STREAM);
+	m_streamHandle = NULL;
+
+	if (m_columnArrayHandle)
+		OCIHandleFree (m_columnArrayHandle, OCI_HTYPE_DIRPATH_COLUMN_ARRAY);
+	m_columnArrayHandle = NULL;
+
+	if (m_ctxHandle)
+		OCIHandleFree (m_ctxHandle, OCI_HTYPE_DIRPATH_CTX);
+	m_ctxHandle = NULL;
+
+	if (m_errorHandle)
+		OCIHandleFree (m_errorHandle, OCI_HTYPE_ERROR);
+	m_errorHandle = NULL;
+}
+
+
+void DirectPathLoader::AddColumn (const TCHAR *columnName, unsigned int maxDataSize, unsigned short ociType, const TCHAR *dateFormat)	// = SQLT_CHR, = NULL
+{
+	EP_ASSERT (columnName && maxDataSize > 0 && !m_ctxHandle);
+
+	LoadColumn column;
+	column.m_name = columnName;
+	column.m_maxDataSize = maxDataSize;
+	column.m_ociType = ociType;
+	if (dateFormat)
+		column.m_dateFormat = dateFormat;
+	m_columns.push_back (column);
+}
+
+
+void DirectPathLoader::Prepare ()
+{
+	EP_ASSERT (m_conn && !m_ctxHandle && !m_columns.empty ());
+
+	int	result;
+
+	if (!m_errorHandle)
+	{
+		result = OCIHandleAlloc (m_conn->m_envHandle, reinterpret_cast <void **> (&m_errorHandle), OCI_HTYPE_ERROR, 0, NULL);
+		if (result != OCI_SUCCESS)
+			throw (OraError(result, m_conn->m_envHandle, __TFILE__, __LINE__));
+	}
+	OCIError *errorHandle = m_errorHandle;
+
+	result = OCIHandleAlloc (m_conn->m_envHandle, reinterpret_cast <void **> (&m_ctxHandle), OCI_HTYPE_DIRPATH_CTX, 0, NULL);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_conn->m_envHandle, __TFILE__, __LINE__));
+
+	try
+	{
+		result = OCIAttrSet (m_ctxHandle, OCI_HTYPE_DIRPATH_CTX, (void *) m_tableName.c_str (), static_cast <unsigned int> (m_tableName.length () * sizeof (TCHAR)), OCI_ATTR_NAME, errorHandle);
+
+		if (result == OCI_SUCCESS && !m_schemaName.empty ())
+			result = OCIAttrSet (m_ctxHandle, OCI_HTYPE_DIRPATH_CTX, (void *) m_schemaName.c_str (), static_cast <unsigned int> (m_schemaName.length () * sizeof (TCHAR)), OCI_ATTR_SCHEMA_NAME, errorHandle);
+
+		if (result == OCI_SUCCESS)
+			result = OCIAttrSet (m_ctxHandle, OCI_HTYPE_DIRPATH_CTX, &m_streamBufferSize, 0, OCI_ATTR_BUF_SIZE, errorHandle);
+
+		if (result != OCI_SUCCESS)
+			throw (OraError(result, errorHandle, __TFILE__, __LINE__, m_tableName.c_str ()));
+
+		describeColumns ();
+
+		result = OCIDirPathPrepare (m_ctxHandle, m_conn->m_svcContextHandle, errorHandle);
+		if (result != OCI_SUCCESS)
+			throw (OraError(result, errorHandle, __TFILE__, __LINE__, m_tableName.c_str ()));
+		m_isPrepared = true;
+
+		result = OCIHandleAlloc (m_ctxHandle, reinterpret_cast <void **> (&m_columnArrayHandle), OCI_HTYPE_DIRPATH_COLUMN_ARRAY, 0, NULL);
+		if (result == OCI_SUCCESS)
+			result = OCIHandleAlloc (m_ctxHandle, reinterpret_cast <void **> (&m_streamHandle), OCI_HTYPE_DIRPATH_STREAM, 0, NULL);
+		if (result != OCI_SUCCESS)
+			throw (OraError(result, m_conn->m_envHandle, __TFILE__, __LINE__));
+
+		result = OCIAttrGet (m_columnArrayHandle, OCI_HTYPE_DIRPATH_COLUMN_ARRAY, &m_columnArrayRows, NULL, OCI_ATTR_NUM_ROWS, errorHandle);
+		if (result != OCI_SUCCESS)
+			throw (OraError(result, errorHandle, __TFILE__, __LINE__));
+	}
+	catch (...)
+	{
+		cleanUp ();
+		throw;
+	}
+}
+
+
+void DirectPathLoader::describeColumns ()
+{
+	int	result;
+	OCIError *errorHandle = m_errorHandle;
+	unsigned short columnCount = static_cast <unsigned short> (m_columns.size ());
+	OCIParam *columnList = NULL;
+
+	result = OCIAttrSet (m_ctxHandle, OCI_HTYPE_DIRPATH_CTX, &columnCount, 0, OCI_ATTR_NUM_COLS, errorHandle);
+	if (result == OCI_SUCCESS)
+		result = OCIAttrGet (m_ctxHandle, OCI_HTYPE_DIRPATH_CTX, &columnList, NULL, OCI_ATTR_LIST_COLUMNS, errorHandle);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, errorHandle, __TFILE__, __LINE__));
+
+	for (unsigned int i=0; i<m_columns.size (); i++)
+	{
+		const LoadColumn &column = m_columns [i];
+		OCIParam *columnHandle = NULL;
+
+		result = OCIParamGet (columnList, OCI_DTYPE_PARAM, errorHandle, reinterpret_cast <void **> (&columnHandle), i + 1);
+
+		if (result == OCI_SUCCESS)
+			result = OCIAttrSet (columnHandle, OCI_DTYPE_PARAM, (void *) column.m_name.c_str (), static_cast <unsigned int> (column.m_name.length () * sizeof (TCHAR)), OCI_ATTR_NAME, errorHandle);
+
+		if (result == OCI_SUCCESS)
+			result = OCIAttrSet (columnHandle, OCI_DTYPE_PARAM, (void *) &column.m_ociType, 0, OCI_ATTR_DATA_TYPE, errorHandle);
+
+		if (result == OCI_SUCCESS)
+			result = OCIAttrSet (columnHandle, OCI_DTYPE_PARAM, (void *) &column.m_maxDataSize, 0, OCI_ATTR_DATA_SIZE, errorHandle);
+
+		if (result == OCI_SUCCESS && !column.m_dateFormat.empty ())
+			result = OCIAttrSet (columnHandle, OCI_DTYPE_PARAM, (void *) column.m_dateFormat.c_str (), static_cast <unsigned int> (column.m_dateFormat.length () * sizeof (TCHAR)), OCI_ATTR_DATEFORMAT, errorHandle);
+
+#if defined(_UNICODE) || defined(UNICODE)
+		if (result == OCI_SUCCESS && column.m_ociType == SQLT_CHR)
+		{
+			unsigned short value = OCI_UTF16ID;
+			result = OCIAttrSet (columnHandle, OCI_DTYPE_PARAM, &value, 0, OCI_ATTR_CHARSET_ID, errorHandle);
+		}
+#endif //defined(_UNICODE) || defined(UNICODE)
+
+		if (columnHandle)
+			OCIDescriptorFree (columnHandle, OCI_DTYPE_PARAM);
+
+		if (result != OCI_SUCCESS)
+			throw (OraError(result, errorHandle, __TFILE__, __LINE__, column.m_name.c_str ()));
+	}
+}
+
+
+void DirectPathLoader::LoadBatch (const DirectPathColumnData *columns, unsigned int rowCount)
+{
+	EP_ASSERT (columns);
+
+	if (!m_isPrepared)
+		throw (OraError(EC_DIRPATH_NOT_PREPARED, __TFILE__, __LINE__, m_tableName.c_str ()));
+
+	int	result = OCI_SUCCESS;
+	OCIError *errorHandle = m_errorHandle;
+	unsigned short columnCount = static_cast <unsigned short> (m_columns.size ());
+
+	for (unsigned int batchRow = 0; batchRow < rowCount; batchRow += m_columnArrayRows)
+	{
+		unsigned int chunkRows = rowCount - batchRow;
+		if (chunkRows > m_columnArrayRows)
+			chunkRows = m_columnArrayRows;
+
+		for (unsigned short col = 0; col < columnCount; col++)
+		{
+			const DirectPathColumnData &column = columns [col];
+			const unsigned char *data = static_cast <const unsigned char *> (column.m_data) + static_cast <size_t> (column.m_stride) * batchRow;
+
+			for (unsigned int row = 0; row < chunkRows; row++, data += column.m_stride)
+			{
+				unsigned int sourceRow = batchRow + row;
+				if (column.m_indicators && column.m_indicators [sourceRow] == ORADATA_NULL)
+					result = OCIDirPathColArrayEntrySet (m_columnArrayHandle, errorHandle, row, col, NULL, 0, OCI_DIRPATH_COL_NULL);
+				else
+				{
+					unsigned int length = column.m_lengths ? column.m_lengths [sourceRow] : column.m_length;
+					result = OCIDirPathColArrayEntrySet (m_columnArrayHandle, errorHandle, row, col, const_cast <unsigned char *> (data), length, OCI_DIRPATH_COL_COMPLETE);
+				}
+				if (result != OCI_SUCCESS)
+					throw (OraError(result, errorHandle, __TFILE__, __LINE__, m_columns [col].m_name.c_str ()));
+			}
+		}
+		convertAndLoad (chunkRows);
+	}
+}
+
+
+void DirectPathLoader::convertAndLoad (unsigned int rowCount)
+{
+	int	result;
+	OCIError *errorHandle = m_errorHandle;
+	unsigned int rowOffset = 0;
+
+	for (;;)
+	{
+		result = OCIDirPathColArrayToStream (m_columnArrayHandle, m_ctxHandle, m_streamHandle, errorHandle, rowCount, rowOffset);
+		if (result != OCI_SUCCESS && result != OCI_CONTINUE)
+		{
+			unsigned int convertedRows = 0;
+			OCIAttrGet (m_columnArrayHandle, OCI_HTYPE_DIRPATH_COLUMN_ARRAY, &convertedRows, NULL, OCI_ATTR_ROW_COUNT, errorHandle);
+			throw (OraError(result, errorHandle, __TFILE__, __LINE__, _T("row %u"), static_cast <unsigned int> (m_rowsLoaded) + rowOffset + convertedRows));
+		}
+
+		int loadResult = OCIDirPathLoadStream (m_ctxHandle, m_streamHandle, errorHandle);
+		if (loadResult == OCI_SUCCESS)
+			loadResult = OCIDirPathStreamReset (m_streamHandle, errorHandle);
+		if (loadResult != OCI_SUCCESS)
+			throw (OraError(loadResult, errorHandle, __TFILE__, __LINE__, m_tableName.c_str ()));
+
+		if (result == OCI_SUCCESS)
+			break;
+
+		// the stream buffer was full, continue after the rows converted so far
+		unsigned int convertedRows = 0;
+		result = OCIAttrGet (m_columnArrayHandle, OCI_HTYPE_DIRPATH_COLUMN_ARRAY, &convertedRows, NULL, OCI_ATTR_ROW_COUNT, errorHandle);
+		if (result != OCI_SUCCESS)
+			throw (OraError(result, errorHandle, __TFILE__, __LINE__));
+		rowOffset += convertedRows;
+	}
+
+	result = OCIDirPathColArrayReset (m_columnArrayHandle, errorHandle);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, errorHandle, __TFILE__, __LINE__));
+	m_rowsLoaded += rowCount;
+}
+
+
+void DirectPathLoader::Finish ()
+{
+	if (!m_isPrepared)
+		throw (OraError(EC_DIRPATH_NOT_PREPARED, __TFILE__, __LINE__, m_tableName.c_str ()));
+
+	int result = OCIDirPathFinish (m_ctxHandle, m_errorHandle);
+	if (result != OCI_SUCCESS)
+	{
+		// the error has to be taken before its handle is freed, the failed load is aborted
+		OraError error (result, m_errorHandle, __TFILE__, __LINE__, m_tableName.c_str ());
+		cleanUp ();
+		throw (error);
+	}
+	m_isPrepared = false;
+	cleanUp ();
+}
+
+
+void DirectPathLoader::Abort ()
+{
+	if (!m_isPrepared)
+		return;
+
+	int result = OCIDirPathAbort (m_ctxHandle, m_errorHandle);
+	m_isPrepared = false;
+	if (result != OCI_SUCCESS)
+	{
+		// the error has to be taken before its handle is freed
+		OraError error (result, m_errorHandle, __TFILE__, __LINE__, m_tableName.c_str ());
+		cleanUp ();
+		throw (error);
+	}
+	cleanUp ();
+}
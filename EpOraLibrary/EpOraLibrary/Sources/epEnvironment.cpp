@@ -0,0 +1,69 @@
+/*! 
+OracleDB Environment for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epEnvironment.h"
+#include "epOraDefines.h"
+#include "epOraError.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+Environment::Environment (unsigned long envMode, unsigned short charsetId, const MemoryCallbacks *callbacks) :SmartObject()	// = OCI_THREADED|OCI_OBJECT, = 0, = NULL
+{
+	m_envHandle = NULL;
+	m_envMode = envMode;
+
+#if defined(_UNICODE) || defined(UNICODE)
+	charsetId = OCI_UTF16ID;
+#endif //defined(_UNICODE) || defined(UNICODE)
+
+	int result;
+	if (callbacks)
+		result = OCIEnvNlsCreate (&m_envHandle, envMode, callbacks->m_context, callbacks->m_malloc, callbacks->m_realloc, callbacks->m_free, 0, NULL, charsetId, charsetId);
+	else
+		result = OCIEnvNlsCreate (&m_envHandle, envMode, NULL, NULL, NULL, NULL, 0, NULL, charsetId, charsetId);
+
+	if (result != OCI_SUCCESS)
+	{
+		if (m_envHandle)
+			OCIHandleFree (m_envHandle, OCI_HTYPE_ENV);
+		m_envHandle = NULL;
+		throw (OraError(EC_ENV_CREATE_FAILED, __TFILE__, __LINE__));
+	}
+}
+
+
+Environment::~Environment ()
+{
+	if (m_envHandle)
+		OCIHandleFree (m_envHandle, OCI_HTYPE_ENV);
+	m_envHandle = NULL;
+}
@@ -0,0 +1,122 @@
+/*! 
+OracleDB Result Set Background Fetcher for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "epFetchWorker.h"
+#include "epResultSet.h"
+#include "epConnection.h"
+#include "epOraError.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+FetchWorker::FetchWorker (ResultSet *rs) :Thread(), m_requestEvent(false,false), m_doneEvent(false,false)
+{
+	EP_ASSERT (rs);
+
+	m_resultSet = rs;
+	m_errorHandle = NULL;
+	m_bufferSet = 0;
+	m_result = OCI_SUCCESS;
+	m_rowsFetched = 0;
+	m_isPending = false;
+	m_isStopping = false;
+
+	int result = OCIHandleAlloc (rs->m_conn->m_envHandle, (void **) &m_errorHandle, OCI_HTYPE_ERROR, 0, NULL);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, rs->m_conn->m_envHandle, __TFILE__, __LINE__));
+
+	if (!Start ())
+	{
+		OCIHandleFree (m_errorHandle, OCI_HTYPE_ERROR);
+		m_errorHandle = NULL;
+		throw (OraError(__TFILE__, __LINE__));
+	}
+}
+
+
+FetchWorker::~FetchWorker ()
+{
+	Stop ();
+	if (m_errorHandle)
+		OCIHandleFree (m_errorHandle, OCI_HTYPE_ERROR);
+	m_errorHandle = NULL;
+}
+
+
+void FetchWorker::Request (unsigned int bufferSet)
+{
+	EP_ASSERT (!m_isPending && !m_isStopping);
+
+	m_bufferSet = bufferSet;
+	m_isPending = true;
+	m_requestEvent.SetEvent ();
+}
+
+
+int FetchWorker::Wait ()
+{
+	// the last fetch failed and nothing was requested since
+	if (!m_isPending)
+		return (m_result);
+
+	m_doneEvent.WaitForEvent ();
+	m_isPending = false;
+	return (m_result);
+}
+
+
+void FetchWorker::Stop ()
+{
+	if (m_isStopping)
+		return;
+
+	if (m_isPending)
+		Wait ();
+	m_isStopping = true;
+	m_requestEvent.SetEvent ();
+	WaitFor ();
+}
+
+
+void FetchWorker::execute ()
+{
+	for (;;)
+	{
+		m_requestEvent.WaitForEvent ();
+		if (m_isStopping)
+			break;
+
+		m_rowsFetched = 0;
+		m_result = m_resultSet->fetchArray (m_bufferSet, m_errorHandle, m_rowsFetched);
+		m_doneEvent.SetEvent ();
+	}
+}
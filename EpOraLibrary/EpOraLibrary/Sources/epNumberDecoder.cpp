@@ -0,0 +1,185 @@
+/*! 
+OracleDB Number Decoder for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epNumberDecoder.h"
+#include "epOraDefines.h"
+#include "epOraError.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+/// the number of base-100 mantissa digits which always fit in 64-bit integer (100^9 = 10^18)
+#define MAX_FAST_DIGITS 9
+/// the largest integer exactly representable in double
+#define MAX_EXACT_MANTISSA 9007199254740992LL
+
+/// exactly representable powers of ten
+static const double s_powersOfTen [] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+	1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+	1e21, 1e22
+};
+
+
+bool NumberDecoder::decode (const OCINumber *number, bool &retIsNegative, __int64 &retMantissa, int &retExponent)
+{
+	// VARNUM: length byte, exponent byte, then up to 20 base-100 digits
+	const ub1 *bytes = number->OCINumberPart;
+	unsigned int length = bytes [0];
+	if (length == 0 || length >= OCI_NUMBER_SIZE)
+		return (false);
+
+	ub1 exponent = bytes [1];
+	if (length == 1)
+	{
+		// zero is a lone 0x80, negative infinity a lone 0x00
+		if (exponent != 0x80)
+			return (false);
+		retIsNegative = false;
+		retMantissa = 0;
+		retExponent = 0;
+		return (true);
+	}
+
+	const ub1 *digits = bytes + 2;
+	unsigned int digitCount = length - 1;
+	__int64 mantissa = 0;
+	unsigned int i;
+
+	if (exponent & 0x80)
+	{
+		// positive: digits are stored as digit + 1
+		if (exponent == 0xFF)
+			return (false);
+		if (digitCount > MAX_FAST_DIGITS)
+			return (false);
+		for (i = 0; i < digitCount; i++)
+			mantissa = mantissa * 100 + (digits [i] - 1);
+		retIsNegative = false;
+		retExponent = static_cast <int> (exponent) - 0xC1 - static_cast <int> (digitCount - 1);
+	}
+	else
+	{
+		// negative: digits are stored as 101 - digit, terminated by 102 when short
+		if (digits [digitCount - 1] == 102)
+			digitCount--;
+		if (digitCount == 0 || digitCount > MAX_FAST_DIGITS)
+			return (false);
+		for (i = 0; i < digitCount; i++)
+			mantissa = mantissa * 100 + (101 - digits [i]);
+		retIsNegative = true;
+		retExponent = 0x3E - static_cast <int> (exponent) - static_cast <int> (digitCount - 1);
+	}
+	retMantissa = mantissa;
+	return (true);
+}
+
+
+bool NumberDecoder::ToInt64 (const OCINumber *number, __int64 &retValue)
+{
+	bool isNegative;
+	__int64 mantissa;
+	int exponent;
+	if (!decode (number, isNegative, mantissa, exponent))
+		return (false);
+
+	// fractional values are left to OCI for its rounding rules
+	if (exponent < 0)
+		return (false);
+	for (; exponent > 0; exponent--)
+	{
+		if (mantissa >= 10000000000000000LL)
+			return (false);
+		mantissa *= 100;
+	}
+	retValue = isNegative ? -mantissa : mantissa;
+	return (true);
+}
+
+
+bool NumberDecoder::ToDouble (const OCINumber *number, double &retValue)
+{
+	bool isNegative;
+	__int64 mantissa;
+	int exponent;
+	if (!decode (number, isNegative, mantissa, exponent))
+		return (false);
+
+	// both operands exact, so the single multiply/divide is correctly rounded
+	if (mantissa > MAX_EXACT_MANTISSA || exponent > 11 || exponent < -11)
+		return (false);
+	double value = static_cast <double> (mantissa);
+	if (exponent >= 0)
+		value *= s_powersOfTen [exponent * 2];
+	else
+		value /= s_powersOfTen [-exponent * 2];
+	retValue = isNegative ? -value : value;
+	return (true);
+}
+
+
+void NumberDecoder::ToInt64Array (OCIError *errorHandle, const OCINumber *numbers, const short *indicators, unsigned int count, __int64 *retValues)
+{
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (indicators && indicators [i] == ORADATA_NULL)
+		{
+			retValues [i] = 0;
+			continue;
+		}
+		if (ToInt64 (numbers + i, retValues [i]))
+			continue;
+
+		sword result = OCINumberToInt (errorHandle, numbers + i, sizeof (__int64), OCI_NUMBER_SIGNED, retValues + i);
+		if (result != OCI_SUCCESS)
+			throw (OraError(result, errorHandle, __TFILE__, __LINE__));
+	}
+}
+
+
+void NumberDecoder::ToDoubleArray (OCIError *errorHandle, const OCINumber *numbers, const short *indicators, unsigned int count, double *retValues)
+{
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (indicators && indicators [i] == ORADATA_NULL)
+		{
+			retValues [i] = 0;
+			continue;
+		}
+		if (ToDouble (numbers + i, retValues [i]))
+			continue;
+
+		sword result = OCINumberToReal (errorHandle, numbers + i, sizeof (double), retValues + i);
+		if (result != OCI_SUCCESS)
+			throw (OraError(result, errorHandle, __TFILE__, __LINE__));
+	}
+}
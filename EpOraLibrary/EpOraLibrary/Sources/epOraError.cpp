@@ -33,97 +33,151 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epol;
 
+/// ORA-00001: unique constraint violated
+#define ORA_UNIQUE_CONSTRAINT 1
+/// ORA-00054: resource busy and acquire with NOWAIT specified or timeout expired
+#define ORA_RESOURCE_BUSY 54
+/// ORA-01403: no data found
+#define ORA_NO_DATA_FOUND 1403
+/// ORA-30006: resource busy; acquire with WAIT timeout expired
+#define ORA_RESOURCE_WAIT_TIMEOUT 30006
+
+
+Status::Status ()
+{
+	m_type = ET_UNKNOWN;
+	m_code = OCI_SUCCESS;
+	m_oraCode = 0;
+	m_rowCount = 0;
+}
+
+
+Status::Status (int oraErr, OCIError *errorHandle)
+{
+	m_type = (oraErr == OCI_SUCCESS) ? ET_UNKNOWN : ET_ORACLE;
+	m_code = oraErr;
+	m_oraCode = 0;
+	m_rowCount = 0;
+
+	// the code only, the text is not wanted on this path
+	if (errorHandle && oraErr != OCI_SUCCESS && oraErr != OCI_INVALID_HANDLE)
+	{
+		OraText errorText [32];
+		OCIErrorGet (errorHandle, 1, NULL, reinterpret_cast<int*>(&m_oraCode), errorText, sizeof (errorText), OCI_HTYPE_ERROR);
+	}
+}
+
+
+bool Status::IsNoData () const
+{
+	return (m_code == OCI_NO_DATA || m_oraCode == ORA_NO_DATA_FOUND);
+}
+
+
+bool Status::IsDuplicateKey () const
+{
+	return (m_oraCode == ORA_UNIQUE_CONSTRAINT);
+}
+
+
+bool Status::IsLockTimeout () const
+{
+	return (m_oraCode == ORA_RESOURCE_BUSY || m_oraCode == ORA_RESOURCE_WAIT_TIMEOUT);
+}
+
+
+void Status::Throw (const TCHAR *sourceName, long lineNumber) const
+{
+	if (!IsSucceeded ())
+		throw (OraError(*this, sourceName, lineNumber));
+}
+
 
 OraError::OraError (int oraErr,OCIError *errorHandle, const TCHAR *sourceName, long lineNumber, const TCHAR *format,...)
 {
-	oracleError (oraErr, errorHandle, NULL);
+	initialize (ET_ORACLE, oraErr, sourceName, lineNumber);
+	if (hasDetails (oraErr))
+		oracleError (errorHandle, NULL);
 
 	if (format)
 	{
 		va_list	va;
 		va_start (va, format);
-		concatMessage (format, va);
+		formatMessage (format, va);
 		va_end (va);
 	}
-
-	m_type = ET_ORACLE;
-	m_winapiCode = 0;
-	m_source = sourceName;
-	m_lineNo = lineNumber;
 }
 
 
 OraError::OraError (int oraErr, OCIEnv *envHandle,const TCHAR *sourceName, long lineNumber, const TCHAR *format,...)
 {
-	oracleError (oraErr,NULL,envHandle);
+	initialize (ET_ORACLE, oraErr, sourceName, lineNumber);
+	if (hasDetails (oraErr))
+		oracleError (NULL, envHandle);
 
 	if (format)
 	{
 		va_list	va;
 		va_start (va, format);
-		concatMessage (format, va);
+		formatMessage (format, va);
 		va_end (va);
 	}
-
-	m_type = ET_ORACLE;
-	m_winapiCode = 0;
-	m_source = sourceName;
-	m_lineNo = lineNumber;
 }
 
 
 OraError::OraError (int oralibErr, const TCHAR *sourceName, long lineNumber, const TCHAR *format, ...)
 {
-	oralibError (oralibErr);
+	initialize (ET_ORALIB, oralibErr, sourceName, lineNumber);
 
 	if (format)
 	{
 		va_list	va;
 		va_start (va, format);
-		concatMessage (format, va);
+		formatMessage (format, va);
 		va_end (va);
 	}
-
-	m_type = ET_ORALIB;
-	m_oraCode = 0;
-	m_winapiCode = 0;
-	m_source = sourceName;
-	m_lineNo = lineNumber;
 }
 
 
 OraError::OraError (const TCHAR *sourceName, long lineNumber,const TCHAR *format,	...)
 {
+	initialize (ET_WINAPI, 0, sourceName, lineNumber);
 	winapiError ();
 
 	if (format)
 	{
 		va_list	va;
 		va_start (va, format);
-		concatMessage (format, va);
+		formatMessage (format, va);
 		va_end (va);
 	}
-
-	m_type = ET_WINAPI;
-	m_code = 0;
-	m_oraCode = 0;
-	m_source = sourceName;
-	m_lineNo = lineNumber;
 }
 
 
 
+OraError::OraError (const Status &status, const TCHAR *sourceName, long lineNumber)
+{
+	initialize (status.m_type, status.m_code, sourceName, lineNumber);
+	m_oraCode = status.m_oraCode;
+
+	// the text was not taken by the Try call
+	if (m_oraCode != 0)
+		formatErrorText (_T("ORA-%05u"), m_oraCode);
+}
+
+
 OraError::OraError (const OraError& err):
 m_type (err.m_type),
 	m_code (err.m_code),
 	m_oraCode (err.m_oraCode),
 	m_winapiCode (err.m_winapiCode),
+	m_lineNo (err.m_lineNo),
 	m_description (err.m_description),
-	m_source (err.m_source),
-	m_lineNo (err.m_lineNo)
+	m_isDescribed (err.m_isDescribed)
 {
-	m_type = err.m_type;
-
+	memcpy (m_errorText, err.m_errorText, sizeof (m_errorText));
+	memcpy (m_message, err.m_message, sizeof (m_message));
+	memcpy (m_source, err.m_source, sizeof (m_source));
 }
 
 
@@ -132,147 +186,189 @@ OraError::~OraError ()
 }
 
 
-void OraError::oracleError(int oraErr,OCIError *errorHandle, OCIEnv *envHandle)
+void OraError::initialize (ErrorTypesEnum type, int code, const TCHAR *sourceName, long lineNumber)
 {
-	bool	getDetails = false;
+	m_type = type;
+	m_code = code;
+	m_oraCode = 0;
+	m_winapiCode = 0;
+	m_errorText[0] = _T('\0');
+	m_message[0] = _T('\0');
+	m_source[0] = _T('\0');
+	if (sourceName)
+	{
+		// the caller's string may not outlive the error, and the end of a long path names the file
+		size_t length = 0;
+		while (sourceName [length])
+			length++;
+		if (length >= ERROR_SOURCE_MAX_LEN)
+			sourceName += length - (ERROR_SOURCE_MAX_LEN-1);
+		epl::System::TcsNCpy (m_source, ERROR_SOURCE_MAX_LEN, sourceName, ERROR_SOURCE_MAX_LEN-1);
+	}
+	m_lineNo = lineNumber;
+	m_isDescribed = false;
+}
 
+
+void OraError::oracleError(OCIError *errorHandle, OCIEnv *envHandle)
+{
 	EP_ASSERT (errorHandle != NULL || envHandle != NULL);
 
-	m_code = oraErr;
+	// the handle is reused by the next call, so its text is taken now
+	if (errorHandle)
+		OCIErrorGet ( errorHandle, 1, NULL, reinterpret_cast<int*>(&m_oraCode), reinterpret_cast<unsigned char *> (m_errorText), sizeof (m_errorText), OCI_HTYPE_ERROR);
+	else
+		OCIErrorGet ( envHandle, 1, NULL, reinterpret_cast<int*>(&m_oraCode), reinterpret_cast<unsigned char *> (m_errorText), sizeof (m_errorText), OCI_HTYPE_ENV);
+	m_errorText[ERROR_TEXT_MAX_LEN-1] = _T('\0');
+}
+
+
+bool OraError::hasDetails (int oraErr)
+{
+	return (oraErr == OCI_SUCCESS_WITH_INFO || oraErr == OCI_ERROR || oraErr == OCI_NO_DATA || oraErr == OCI_STILL_EXECUTING);
+}
+
+
+const TCHAR *OraError::oracleText (int oraErr)
+{
 	switch (oraErr)
 	{
 	case	OCI_SUCCESS:
-		m_description = _T("(OCI_SUCCESS)");
-		break;
+		return (_T("(OCI_SUCCESS)"));
 
 	case	OCI_SUCCESS_WITH_INFO:
-		m_description = _T("(OCI_SUCCESS_WITH_INFO)");
-		getDetails = true;
-		break;
+		return (_T("(OCI_SUCCESS_WITH_INFO)"));
 
 	case	OCI_ERROR:
-		m_description = _T("(OCI_ERROR)");
-		getDetails = true;
-		break;
+		return (_T("(OCI_ERROR)"));
 
 	case	OCI_NO_DATA:
-		m_description = _T("(OCI_NO_DATA)");
-		getDetails = true;
-		break;
+		return (_T("(OCI_NO_DATA)"));
 
 	case	OCI_INVALID_HANDLE:
-		m_description = _T("(OCI_INVALID_HANDLE)");
-		break;
+		return (_T("(OCI_INVALID_HANDLE)"));
 
 	case	OCI_NEED_DATA:
-		m_description = _T("(OCI_NEED_DATA)");
-		break;
+		return (_T("(OCI_NEED_DATA)"));
 
 	case	OCI_STILL_EXECUTING:
-		m_description = _T("(OCI_STILL_EXECUTING)");
-		getDetails = true;
-		break;
+		return (_T("(OCI_STILL_EXECUTING)"));
 
 	case	OCI_CONTINUE:
-		m_description = _T("(OCI_CONTINUE)");
-		break;
+		return (_T("(OCI_CONTINUE)"));
 
 	default:
-		m_description = _T("unknown");
-	}
-	if (getDetails)
-	{
-		const int	maxTextLen = 4000;
-		char	*errorText = EP_NEW char [maxTextLen];
-
-		if (errorText)
-		{
-			*errorText = '\0';
-			if (errorHandle)
-				OCIErrorGet ( errorHandle, 1, NULL, reinterpret_cast<int*>(&m_oraCode), reinterpret_cast<unsigned char *> (errorText), maxTextLen, OCI_HTYPE_ERROR);
-			else
-				OCIErrorGet ( envHandle, 1, NULL, reinterpret_cast<int*>(&m_oraCode), reinterpret_cast<unsigned char *> (errorText),	maxTextLen, OCI_HTYPE_ENV);
-
-			m_description += _T(" ");
-#if defined(_UNICODE) || defined(UNICODE)
-			 m_description +=(wchar_t *)errorText;
-#else // defined(_UNICODE) || defined(UNICODE)
-			 m_description += errorText;
-#endif // defined(_UNICODE) || defined(UNICODE)
-			EP_DELETE [] errorText;
-		}
+		return (_T("unknown"));
 	}
 }
 
 
-void OraError::oralibError (int oralibErr)
+const TCHAR *OraError::oralibText (int oralibErr)
 {
-	m_code = oralibErr;
 	switch (oralibErr)
 	{
 	case	EC_ENV_CREATE_FAILED:
-		m_description = _T("(EC_ENV_CREATE_FAILED) Environment handle creation failed");
-		break;
+		return (_T("(EC_ENV_CREATE_FAILED) Environment handle creation failed"));
 
 	case	EC_TIMEOUT:
-		m_description = _T("(EC_TIMEOUT) Statement took too long to complete and has been aborted");
-		break;
+		return (_T("(EC_TIMEOUT) Statement took too long to complete and has been aborted"));
 
 	case	EC_NO_MEMORY:
-		m_description = _T("(EC_NO_MEMORY) Memory allocation request has failed");
-		break;
+		return (_T("(EC_NO_MEMORY) Memory allocation request has failed"));
 
 	case	EC_BAD_PARAM_TYPE:
-		m_description = _T("(EC_BAD_PARAM_TYPE) Parameter type is incorrect");
-		break;
+		return (_T("(EC_BAD_PARAM_TYPE) Parameter type is incorrect"));
 
 	case	EC_POOL_NOT_SETUP:
-		m_description = _T("(EC_POOL_NOT_SETUP) Connection pool has not been setup yet");
-		break;
+		return (_T("(EC_POOL_NOT_SETUP) Connection pool has not been setup yet"));
 
 	case	EC_BAD_INPUT_TYPE:
-		m_description = _T("(EC_BAD_INPUT_TYPE) Input data doesn't have expected type");
-		break;
+		return (_T("(EC_BAD_INPUT_TYPE) Input data doesn't have expected type"));
 
 	case	EC_BAD_OUTPUT_TYPE:
-		m_description = _T("(EC_BAD_OUTPUT_TYPE) Cannot convert to requested type");
-		break;
+		return (_T("(EC_BAD_OUTPUT_TYPE) Cannot convert to requested type"));
 
 	case	EC_BAD_TRANSFORM:
-		m_description = _T("(EC_BAD_TRANSFORM) Requested transformation is not possible");
-		break;
+		return (_T("(EC_BAD_TRANSFORM) Requested transformation is not possible"));
 
 	case	EC_BAD_PARAM_PREFIX:
-		m_description = _T("(EC_BAD_PARAM_PREFIX) Parameter prefix is not known");
-		break;
+		return (_T("(EC_BAD_PARAM_PREFIX) Parameter prefix is not known"));
 
 	case	EC_INTERNAL:
-		m_description = _T("(EC_INTERNAL) Internal library error. Please, report to developers");
-		break;
+		return (_T("(EC_INTERNAL) Internal library error. Please, report to developers"));
 
 	case	EC_UNSUP_ORA_TYPE:
-		m_description = _T("(EC_UNSUP_ORA_TYPE) Unsupported Oracle type - cannot be converted to numeric, date or text");
-		break;
+		return (_T("(EC_UNSUP_ORA_TYPE) Unsupported Oracle type - cannot be converted to numeric, date or text"));
 
 	case	EC_PARAMETER_NOT_FOUND:
-		m_description = _T("(EC_PARAMETER_NOT_FOUND) Name not found in statement's parameters");
-		break;
+		return (_T("(EC_PARAMETER_NOT_FOUND) Name not found in statement's parameters"));
 
 	case	EC_COLUMN_NOT_FOUND:
-		m_description = _T("(EC_COLUMN_NOT_FOUND) Result set doesn't contain column with such name");
-		break;
+		return (_T("(EC_COLUMN_NOT_FOUND) Result set doesn't contain column with such name"));
+
+	case	EC_BAD_FETCH_MODE:
+		return (_T("(EC_BAD_FETCH_MODE) Operation is not allowed in the fetch mode of the result set"));
+
+	case	EC_DIRPATH_NOT_PREPARED:
+		return (_T("(EC_DIRPATH_NOT_PREPARED) Direct path load has not been prepared or is already finished"));
 
 	default:
-		m_description = _T("unknown");
+		return (_T("unknown"));
 	}
 }
 
+void OraError::formatErrorText (const TCHAR *format, ...)
+{
+	va_list	va;
+	va_start (va, format);
+	epl::System::STPrintf_V(m_errorText,ERROR_TEXT_MAX_LEN-1,format,va);
+	va_end (va);
+	m_errorText[ERROR_TEXT_MAX_LEN-1] = _T('\0');
+}
+
+
 void OraError::winapiError ()
 {
-	epl::System::FormatLastErrorMessage(m_description,&m_winapiCode);
+	epl::System::FormatLastErrorMessage(m_errorText, ERROR_TEXT_MAX_LEN, &m_winapiCode);
 }
 
 
+const epl::EpTString &OraError::GetDescription () const
+{
+	if (m_isDescribed)
+		return m_description;
+
+	switch (m_type)
+	{
+	case	ET_ORACLE:
+		m_description = oracleText (m_code);
+		if (hasDetails (m_code))
+		{
+			m_description += _T(" ");
+			m_description += m_errorText;
+		}
+		break;
+
+	case	ET_ORALIB:
+		m_description = oralibText (m_code);
+		break;
+
+	case	ET_WINAPI:
+		m_description = m_errorText;
+		break;
+
+	default:
+		m_description = _T("unknown");
+	}
+
+	if (m_message[0] != _T('\0'))
+	{
+		m_description += _T(": ");
+		m_description += m_message;
+	}
+	m_isDescribed = true;
+	return m_description;
+}
 
 
 epl::EpTString OraError::Details () const
@@ -290,23 +386,16 @@ epl::EpTString OraError::Details () const
 	retString+= _T("Error Type: ");
 	retString+=errorTypesText [m_type];
 	retString+=_T("\nDescription: ");
-	retString+= m_description;
+	retString+= GetDescription ();
 	retString+= _T("\n");
 	return retString;
 }
 
 
-void OraError::concatMessage (const TCHAR *format, va_list va)
+void OraError::formatMessage (const TCHAR *format, va_list va)
 {
 	EP_ASSERT (format && va);
 
-	TCHAR *buffer = EP_NEW TCHAR [ERROR_FORMAT_MAX_MSG_LEN];
-	if (buffer)
-	{
-		epl::System::STPrintf_V(buffer,ERROR_FORMAT_MAX_MSG_LEN-1,format,va);
-		m_description += _T(": ");
-		m_description += buffer;
-		EP_DELETE [] buffer;
-	}
+	epl::System::STPrintf_V(m_message,ERROR_FORMAT_MAX_MSG_LEN-1,format,va);
+	m_message[ERROR_FORMAT_MAX_MSG_LEN-1] = _T('\0');
 }
-
@@ -0,0 +1,282 @@
+/*! 
+OracleDB Parallel Select for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epParallelSelect.h"
+#include "epAsyncExecutor.h"
+#include "epSessionPool.h"
+#include "epConnection.h"
+#include "epStatement.h"
+#include "epParameter.h"
+#include "epColumn.h"
+#include "epResultSet.h"
+#include "epOraError.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+namespace epol
+{
+	/*!
+	@class PartitionCallback
+	@brief Hands the result set of a partition job to the partition handler
+	*/
+	class PartitionCallback:public QueryCallback
+	{
+	public:
+		PartitionCallback (PartitionHandler *handler, unsigned int partition)
+		{
+			m_handler = handler;
+			m_partition = partition;
+		}
+
+		virtual void OnResultSet (QueryJob &job, ResultSet &resultSet)
+		{
+			m_handler->OnPartition (m_partition, resultSet);
+		}
+
+		virtual void OnComplete (QueryJob &job)
+		{
+		}
+
+	private:
+		/// the consumer of the partition
+		PartitionHandler *m_handler;
+		/// the index of the partition
+		unsigned int m_partition;
+	};
+}
+
+
+/*!
+Return the decimal text of given number
+@param[in] value the number
+@return the text of the number
+*/
+static epl::EpTString numberText (unsigned int value)
+{
+	TCHAR digits [16];
+	TCHAR *digit = digits + 15;
+	*digit = _T('\0');
+	do
+	{
+		*--digit = static_cast <TCHAR> (_T('0') + value % 10);
+		value /= 10;
+	}
+	while (value);
+	return epl::EpTString(digit);
+}
+
+
+/// the query splitting the extents of a table into groups of about the same number of blocks, one row id range per group and data object
+static const TCHAR *rowidRangesStmt =
+	_T("SELECT grp AS range_group, ")
+	_T("ROWIDTOCHAR (DBMS_ROWID.ROWID_CREATE (1, data_object_id, ")
+	_T("MIN (relative_fno) KEEP (DENSE_RANK FIRST ORDER BY relative_fno, block_id), ")
+	_T("MIN (block_id) KEEP (DENSE_RANK FIRST ORDER BY relative_fno, block_id), 0)) AS low_rowid, ")
+	_T("ROWIDTOCHAR (DBMS_ROWID.ROWID_CREATE (1, data_object_id, ")
+	_T("MAX (relative_fno) KEEP (DENSE_RANK LAST ORDER BY relative_fno, block_id), ")
+	_T("MAX (block_id + blocks - 1) KEEP (DENSE_RANK LAST ORDER BY relative_fno, block_id), 32767)) AS high_rowid ")
+	_T("FROM (SELECT o.data_object_id, e.relative_fno, e.block_id, e.blocks, ")
+	_T("TRUNC ((SUM (e.blocks) OVER (ORDER BY o.data_object_id, e.relative_fno, e.block_id) - e.blocks) * :partitionCount / SUM (e.blocks) OVER ()) grp ")
+	_T("FROM dba_extents e, dba_objects o ")
+	_T("WHERE e.owner = NVL (:owner, SYS_CONTEXT ('USERENV', 'CURRENT_SCHEMA')) AND e.segment_name = :tableName AND e.segment_type LIKE 'TABLE%' ")
+	_T("AND o.owner = e.owner AND o.object_name = e.segment_name AND o.object_type LIKE 'TABLE%' ")
+	_T("AND NVL (o.subobject_name, ' ') = NVL (e.partition_name, ' ')) ")
+	_T("GROUP BY grp, data_object_id ORDER BY grp, data_object_id");
+
+
+ParallelSelect::ParallelSelect (SessionPool &pool, const TCHAR *selectStmt, unsigned int workerCount)
+{
+	EP_ASSERT (selectStmt);
+
+	pool.RetainObj ();
+	m_pool = &pool;
+	m_selectStmt = selectStmt;
+	m_workerCount = workerCount;
+}
+
+
+ParallelSelect::~ParallelSelect ()
+{
+	m_pool->ReleaseObj ();
+}
+
+
+void ParallelSelect::AddPartition (const TCHAR *predicate)
+{
+	EP_ASSERT (predicate);
+	m_predicates.push_back (epl::EpTString(predicate));
+}
+
+
+void ParallelSelect::AddHashPartitions (const TCHAR *expression, unsigned int partitionCount)
+{
+	EP_ASSERT (expression && partitionCount > 0);
+
+	for (unsigned int i = 0; i < partitionCount; i++)
+	{
+		epl::EpTString predicate (_T("ORA_HASH("));
+		predicate += expression;
+		predicate += _T(", ") + numberText (partitionCount - 1) + _T(") = ") + numberText (i);
+		m_predicates.push_back (predicate);
+	}
+}
+
+
+unsigned int ParallelSelect::AddRowidPartitions (const TCHAR *tableName, unsigned int partitionCount, const TCHAR *owner, const TCHAR *rowidExpression)
+{
+	EP_ASSERT (tableName && rowidExpression && partitionCount > 0);
+
+	std::vector <epl::EpTString> predicates;
+	Connection *conn = m_pool->Borrow ();
+	try
+	{
+		Statement *statement = conn->Prepare (rowidRangesStmt);
+		try
+		{
+			statement->Bind (_T(":partitionCount"), DT_NUMBER) = static_cast <long> (partitionCount);
+			statement->Bind (_T(":tableName"), DT_TEXT) = epl::EpTString(tableName);
+			if (owner)
+				statement->Bind (_T(":owner"), DT_TEXT) = epl::EpTString(owner);
+			else
+				statement->Bind (_T(":owner"), DT_TEXT).ToNull ();
+
+			ResultSet *resultSet = statement->Select ();
+			try
+			{
+				// the ranges of a partitioned table's segments in one group are OR'ed together
+				long group = -1;
+				while (resultSet->Next ())
+				{
+					epl::EpTString range (rowidExpression);
+					range += _T(" BETWEEN CHARTOROWID ('") + (*resultSet)[_T("LOW_ROWID")].ToString () + _T("') AND CHARTOROWID ('") + (*resultSet)[_T("HIGH_ROWID")].ToString () + _T("')");
+
+					if ((*resultSet)[_T("RANGE_GROUP")].ToLong () != group)
+					{
+						group = (*resultSet)[_T("RANGE_GROUP")].ToLong ();
+						predicates.push_back (range);
+					}
+					else
+						predicates.back () += _T(" OR ") + range;
+				}
+			}
+			catch (...)
+			{
+				resultSet->ReleaseObj ();
+				throw;
+			}
+			resultSet->ReleaseObj ();
+		}
+		catch (...)
+		{
+			statement->ReleaseObj ();
+			throw;
+		}
+		statement->ReleaseObj ();
+	}
+	catch (...)
+	{
+		m_pool->Return (conn);
+		throw;
+	}
+	m_pool->Return (conn);
+
+	m_predicates.insert (m_predicates.end (), predicates.begin (), predicates.end ());
+	return static_cast <unsigned int> (predicates.size ());
+}
+
+
+epl::EpTString ParallelSelect::GetPartitionStatement (unsigned int partition) const
+{
+	EP_ASSERT (partition < m_predicates.size ());
+
+	const epl::EpTString &predicate = m_predicates.at (partition);
+	const epl::EpTString marker (PARALLEL_SELECT_PREDICATE_MARKER);
+
+	epl::EpTString stmt (m_selectStmt);
+	size_t position = stmt.find (marker);
+	if (position == epl::EpTString::npos)
+		return epl::EpTString(_T("SELECT * FROM (")) + m_selectStmt + _T(") WHERE ") + predicate;
+
+	while (position != epl::EpTString::npos)
+	{
+		stmt.replace (position, marker.length (), _T("(") + predicate + _T(")"));
+		position = stmt.find (marker, position + predicate.length () + 2);
+	}
+	return stmt;
+}
+
+
+unsigned __int64 ParallelSelect::Run (PartitionHandler &handler, epl::Priority priority)
+{
+	unsigned int partitionCount = GetPartitionCount ();
+	if (partitionCount == 0)
+		return (0);
+
+	unsigned int workerCount = m_workerCount;
+	if (workerCount == 0 || workerCount > partitionCount)
+		workerCount = partitionCount;
+
+	std::vector <PartitionCallback> callbacks;
+	std::vector <QueryJob *> jobs;
+	callbacks.reserve (partitionCount);
+	jobs.reserve (partitionCount);
+
+	unsigned __int64 rowCount = 0;
+	try
+	{
+		AsyncExecutor executor (*m_pool, workerCount);
+		for (unsigned int i = 0; i < partitionCount; i++)
+		{
+			callbacks.push_back (PartitionCallback (&handler, i));
+			QueryJob *job = EP_NEW QueryJob (GetPartitionStatement (i).c_str (), priority, &callbacks.back ());
+			jobs.push_back (job);
+			executor.Submit (*job);
+		}
+		executor.WaitAll ();
+
+		// every partition is done, report the first failure
+		for (std::vector <QueryJob *>::iterator i = jobs.begin (); i != jobs.end (); ++i)
+		{
+			(*i)->Wait ();
+			rowCount += (*i)->GetRowCount ();
+		}
+	}
+	catch (...)
+	{
+		for (std::vector <QueryJob *>::iterator i = jobs.begin (); i != jobs.end (); ++i)
+			(*i)->ReleaseObj ();
+		throw;
+	}
+	for (std::vector <QueryJob *>::iterator i = jobs.begin (); i != jobs.end (); ++i)
+		(*i)->ReleaseObj ();
+	return (rowCount);
+}
@@ -39,12 +39,12 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epol;
 
-Parameter::Parameter (Statement *to, const TCHAR *name, DataTypesEnum type, unsigned int fetchSize) :SmartObject()		// = FETCH_SIZE
+Parameter::Parameter (Statement *to, const TCHAR *name, DataTypesEnum type, unsigned int fetchSize, unsigned int arraySize, unsigned int maxTextLength) :SmartObject()		// = FETCH_SIZE, = 1, = 0
 {
 	initialize ();
 	try
 	{
-		attach (to, name, type, fetchSize);
+		attach (to, name, type, fetchSize, arraySize, maxTextLength);
 	}
 	catch (...)
 	{
@@ -65,9 +65,11 @@ void Parameter::initialize ()
 	m_paramType = DT_UNKNOWN;
 	m_ociType = 0;
 	m_size = 0;
-	m_indicator = ORADATA_OK;
-	m_dataLen = 0;
+	m_indicators = NULL;
+	m_dataLengths = NULL;
 	m_fetchBuffer = NULL;
+	m_arraySize = 0;
+	m_currentCell = 0;
 	m_isArray = false;
 	m_stmt = NULL;
 	m_bindHandle = NULL;
@@ -94,20 +96,31 @@ void Parameter::cleanUp ()
 	if (m_fetchBuffer) 
 		EP_DELETE [] m_fetchBuffer;
 	m_fetchBuffer = NULL;
+
+	if (m_indicators) 
+		EP_DELETE [] m_indicators;
+	m_indicators = NULL;
+
+	if (m_dataLengths) 
+		EP_DELETE [] m_dataLengths;
+	m_dataLengths = NULL;
 }
 
 
-void Parameter::attach (Statement *to, const TCHAR *name, DataTypesEnum type, unsigned int fetchSize)
+void Parameter::attach (Statement *to, const TCHAR *name, DataTypesEnum type, unsigned int fetchSize, unsigned int arraySize, unsigned int maxTextLength)
 {
-	EP_ASSERT (name && to);
+	EP_ASSERT (name && to && arraySize > 0);
 
 	m_paramName = name;
 
-	setupType (name, type);
-
-	m_indicator = ORADATA_NULL; 
-	m_dataLen = 0;
+	setupType (name, type, maxTextLength);
+	if (arraySize > 1)
+		m_isArray = true;
+	m_arraySize = arraySize;
+	m_currentCell = 0;
 
+	m_indicators = NULL; 
+	m_dataLengths = NULL;
 	m_fetchBuffer = NULL;
 
 	m_stmt = NULL;
@@ -122,7 +135,7 @@ void Parameter::attach (Statement *to, const TCHAR *name, DataTypesEnum type, un
 }
 
 
-void Parameter::setupType (const TCHAR *paramName, DataTypesEnum type)
+void Parameter::setupType (const TCHAR *paramName, DataTypesEnum type, unsigned int maxTextLength)
 {
 	EP_ASSERT (paramName);
 
@@ -154,6 +167,37 @@ void Parameter::setupType (const TCHAR *paramName, DataTypesEnum type)
 		m_paramType = DT_TEXT;
 		m_ociType = SQLT_STR;
 		m_size = MAX_OUTPUT_TEXT_BYTES;
+		if (maxTextLength > 0)
+		{
+			// the length of each cell is returned in unsigned short
+			if ((maxTextLength + 1) * sizeof (TCHAR) > 0xFFFF)
+				throw (OraError(EC_BAD_PARAM_TYPE, __TFILE__, __LINE__, paramName));
+			m_size = static_cast <unsigned short> ((maxTextLength + 1) * sizeof (TCHAR));
+		}
+	}
+	else if (type == DT_INT32)
+	{
+		m_paramType = DT_INT32;
+		m_ociType = SQLT_INT;
+		m_size = sizeof (int);
+	}
+	else if (type == DT_INT64)
+	{
+		m_paramType = DT_INT64;
+		m_ociType = SQLT_INT;
+		m_size = sizeof (__int64);
+	}
+	else if (type == DT_UINT64)
+	{
+		m_paramType = DT_UINT64;
+		m_ociType = SQLT_UIN;
+		m_size = sizeof (unsigned __int64);
+	}
+	else if (type == DT_DOUBLE)
+	{
+		m_paramType = DT_DOUBLE;
+		m_ociType = SQLT_BDOUBLE;
+		m_size = sizeof (double);
 	}
 	else if (type == DT_RESULT_SET || (type == DT_UNKNOWN && pParamName [0] == PP_RESULT_SET))
 	{
@@ -166,25 +210,68 @@ void Parameter::setupType (const TCHAR *paramName, DataTypesEnum type)
 }
 
 
+bool Parameter::isCompatible (DataTypesEnum type, unsigned int arraySize, unsigned int maxTextLength) const
+{
+	if (m_paramType == DT_RESULT_SET || arraySize != m_arraySize)
+		return false;
+	if (type != DT_UNKNOWN && type != m_paramType)
+		return false;
+	if (m_paramType == DT_TEXT)
+	{
+		unsigned int size = (maxTextLength > 0) ? (maxTextLength + 1) * sizeof (TCHAR) : MAX_OUTPUT_TEXT_BYTES;
+		return (size == m_size);
+	}
+	return true;
+}
+
+
+void Parameter::reset ()
+{
+	m_currentCell = 0;
+
+	if (m_resultSet) 
+		m_resultSet->ReleaseObj();
+	m_resultSet = NULL;
+
+	if (m_indicators)
+		for (unsigned int cell = 0; cell < m_arraySize; cell++)
+			m_indicators [cell] = ORADATA_NULL;
+}
+
+
 void Parameter::bind (Statement *to)
 {
 	EP_ASSERT (to);
 
 	int	result;
 
-	m_fetchBuffer = EP_NEW char [m_size];
+	unsigned int cell;
+
+	m_fetchBuffer = EP_NEW char [m_size * m_arraySize];
+	m_indicators = EP_NEW short [m_arraySize];
+	m_dataLengths = EP_NEW unsigned short [m_arraySize];
+	if (!m_fetchBuffer || !m_indicators || !m_dataLengths)
+		throw (OraError(EC_NO_MEMORY, __TFILE__, __LINE__));
+
 	switch (m_paramType)
 	{
 	case	DT_NUMBER:
-		OCINumberSetZero (to->m_conn->m_errorHandle, (OCINumber *) m_fetchBuffer);
+		OCINumberSetZero (to->m_errorHandle, (OCINumber *) m_fetchBuffer);
 		break;
 
 	case	DT_DATE:
-		OCIDateSysDate ( to->m_conn->m_errorHandle, (OCIDate *) m_fetchBuffer);
+		OCIDateSysDate ( to->m_errorHandle, (OCIDate *) m_fetchBuffer);
 		break;
 
 	case	DT_TEXT:
-		*((wchar_t *) m_fetchBuffer) = _T('\0');
+		*((TCHAR *) m_fetchBuffer) = _T('\0');
+		break;
+
+	case	DT_INT32:
+	case	DT_INT64:
+	case	DT_UINT64:
+	case	DT_DOUBLE:
+		memset (m_fetchBuffer, 0, m_size);
 		break;
 
 	default:
@@ -192,19 +279,26 @@ void Parameter::bind (Statement *to)
 		throw (OraError(EC_INTERNAL, __TFILE__, __LINE__, _T("Unsupported internal type")));
 	}
 
-	m_dataLen = static_cast<short> (m_size);
-	result = OCIBindByName (to->m_stmtHandle, &m_bindHandle, to->m_conn->m_errorHandle, (unsigned char *) (m_paramName.data ()), static_cast<unsigned int>(m_paramName.length ()*sizeof(TCHAR)), m_fetchBuffer, m_size, m_ociType, &m_indicator,	&m_dataLen,	NULL,0,	NULL,OCI_DEFAULT);
+	for (cell = 0; cell < m_arraySize; cell++)
+	{
+		if (cell > 0)
+			memcpy (m_fetchBuffer + m_size * cell, m_fetchBuffer, m_size);
+		m_indicators [cell] = ORADATA_NULL;
+		m_dataLengths [cell] = m_size;
+	}
+
+	result = OCIBindByName (to->m_stmtHandle, &m_bindHandle, to->m_errorHandle, (unsigned char *) (m_paramName.data ()), static_cast<unsigned int>(m_paramName.length ()*sizeof(TCHAR)), m_fetchBuffer, m_size, m_ociType, m_indicators,	m_dataLengths,	NULL,0,	NULL,OCI_DEFAULT);
 
 #if defined(_UNICODE) || defined(UNICODE)
 	if (result == OCI_SUCCESS)
 	{
 		unsigned int value = OCI_UTF16ID;
-		result = OCIAttrSet (m_bindHandle, OCI_HTYPE_BIND, &value, sizeof (value), OCI_ATTR_CHARSET_ID, to->m_conn->m_errorHandle);
+		result = OCIAttrSet (m_bindHandle, OCI_HTYPE_BIND, &value, sizeof (value), OCI_ATTR_CHARSET_ID, to->m_errorHandle);
 	}
 #endif // defined(_UNICODE) || defined(UNICODE)
 
 	if (result != OCI_SUCCESS)
-		throw (OraError(result, to->m_conn->m_errorHandle, __TFILE__, __LINE__, m_paramName.c_str ()));
+		throw (OraError(result, to->m_errorHandle, __TFILE__, __LINE__, m_paramName.c_str ()));
 	m_stmt = to;
 }
 
@@ -219,12 +313,12 @@ void Parameter::bindResultSet (Statement *to, unsigned int fetchSize)
 
 	if (result == OCI_SUCCESS)
 	{
-		result = OCIBindByName ( to->m_stmtHandle,&m_bindHandle, to->m_conn->m_errorHandle,(text *) m_paramName.data (),static_cast<unsigned int>(m_paramName.length ()*sizeof(TCHAR)), &m_rsHandle, m_size, m_ociType, NULL, NULL, NULL, 0, NULL, OCI_DEFAULT);
+		result = OCIBindByName ( to->m_stmtHandle,&m_bindHandle, to->m_errorHandle,(text *) m_paramName.data (),static_cast<unsigned int>(m_paramName.length ()*sizeof(TCHAR)), &m_rsHandle, m_size, m_ociType, NULL, NULL, NULL, 0, NULL, OCI_DEFAULT);
 #if defined(_UNICODE) || defined(UNICODE)
 		if (result == OCI_SUCCESS)
 		{
 			unsigned int value = OCI_UTF16ID;
-			result = OCIAttrSet (m_bindHandle, OCI_HTYPE_BIND, &value, sizeof (value), OCI_ATTR_CHARSET_ID, to->m_conn->m_errorHandle);
+			result = OCIAttrSet (m_bindHandle, OCI_HTYPE_BIND, &value, sizeof (value), OCI_ATTR_CHARSET_ID, to->m_errorHandle);
 		}
 #endif // defined(_UNICODE) || defined(UNICODE)
 
@@ -233,38 +327,47 @@ void Parameter::bindResultSet (Statement *to, unsigned int fetchSize)
 		throw (OraError(result, to->m_conn->m_envHandle, __TFILE__, __LINE__));
 
 	if (result != OCI_SUCCESS)
-		throw (OraError(result, to->m_conn->m_errorHandle, __TFILE__, __LINE__, m_paramName.c_str ()));
+		throw (OraError(result, to->m_errorHandle, __TFILE__, __LINE__, m_paramName.c_str ()));
 	m_stmt = to;
 }
 
 
+Parameter& Parameter::operator [] (unsigned int cell)
+{
+	if (cell >= m_arraySize)
+		throw (OraError(EC_BAD_PARAM_TYPE, __TFILE__, __LINE__, _T("%s[%u]"), m_paramName.c_str (), cell));
+	m_currentCell = cell;
+	return (*this);
+}
+
+
 Parameter& Parameter::operator = (epl::EpTString text)
 {
 	EP_ASSERT (m_stmt);
 
 	if (text.length()<=0)
-		m_indicator = ORADATA_NULL;
+		m_indicators [m_currentCell] = ORADATA_NULL;
 	else if (m_paramType == DT_TEXT)
 	{
 
 #if defined(_UNICODE) || defined(UNICODE)
-		m_dataLen = static_cast <unsigned short> (text.length() * 2);
+		m_dataLengths [m_currentCell] = static_cast <unsigned short> (text.length() * 2);
 #else// defined(_UNICODE) || defined(UNICODE)
-		m_dataLen = static_cast <unsigned short> (text.length());
+		m_dataLengths [m_currentCell] = static_cast <unsigned short> (text.length());
 #endif// defined(_UNICODE) || defined(UNICODE)
 		////////////////////////////////////////////////////////////////////////////////////////
-		if (m_dataLen > m_size)
-			m_dataLen = static_cast <unsigned short> ((m_size - 2) & ~1);
-		memcpy (m_fetchBuffer, text.c_str(), m_dataLen);
+		if (m_dataLengths [m_currentCell] >= m_size)
+			m_dataLengths [m_currentCell] = static_cast <unsigned short> ((m_size - 2) & ~1);
+		memcpy (currentBuffer (), text.c_str(), m_dataLengths [m_currentCell]);
 
 #if defined(_UNICODE) || defined(UNICODE)
-		*((wchar_t *) m_fetchBuffer + m_dataLen / 2) = _T('\0');
-		m_dataLen += sizeof (wchar_t);
+		*((wchar_t *) currentBuffer () + m_dataLengths [m_currentCell] / 2) = _T('\0');
+		m_dataLengths [m_currentCell] += sizeof (wchar_t);
 #else// defined(_UNICODE) || defined(UNICODE)
-		*((char *) m_fetchBuffer + m_dataLen) = '\0';
-		m_dataLen += sizeof (char);
+		*((char *) currentBuffer () + m_dataLengths [m_currentCell]) = '\0';
+		m_dataLengths [m_currentCell] += sizeof (char);
 #endif// defined(_UNICODE) || defined(UNICODE)
-		m_indicator = ORADATA_OK; 
+		m_indicators [m_currentCell] = ORADATA_OK; 
 	}
 	else
 		throw (OraError(EC_BAD_INPUT_TYPE, __TFILE__, __LINE__));
@@ -278,10 +381,15 @@ Parameter& Parameter::operator = (double value)
 
 	if (m_paramType == DT_NUMBER)
 	{
-		sword result = OCINumberFromReal (m_stmt->m_conn->m_errorHandle, &value, sizeof (double), reinterpret_cast <OCINumber *> (m_fetchBuffer));
+		sword result = OCINumberFromReal (m_stmt->m_errorHandle, &value, sizeof (double), reinterpret_cast <OCINumber *> (currentBuffer ()));
 		if (result != OCI_SUCCESS)
-			throw (OraError(result, m_stmt->m_conn->m_errorHandle, __TFILE__, __LINE__));
-		m_indicator = ORADATA_OK; 
+			throw (OraError(result, m_stmt->m_errorHandle, __TFILE__, __LINE__));
+		m_indicators [m_currentCell] = ORADATA_OK; 
+	}
+	else if (m_paramType == DT_DOUBLE)
+	{
+		*reinterpret_cast <double *> (currentBuffer ()) = value;
+		m_indicators [m_currentCell] = ORADATA_OK; 
 	}
 	else
 		throw (OraError(EC_BAD_INPUT_TYPE, __TFILE__, __LINE__));
@@ -289,19 +397,93 @@ Parameter& Parameter::operator = (double value)
 }
 
 
+Parameter& Parameter::operator = (int value)
+{
+	return (*this = static_cast <__int64> (value));
+}
+
+
 Parameter& Parameter::operator = (long value)
+{
+	return (*this = static_cast <__int64> (value));
+}
+
+
+Parameter& Parameter::operator = (__int64 value)
 {
 	EP_ASSERT (m_stmt);
 
-	if (m_paramType == DT_NUMBER)
+	switch (m_paramType)
 	{
-		int result = OCINumberFromInt ( m_stmt->m_conn->m_errorHandle, &value, sizeof (long), OCI_NUMBER_SIGNED, reinterpret_cast <OCINumber *> (m_fetchBuffer));
-		if (result != OCI_SUCCESS)
-			throw (OraError(result, m_stmt->m_conn->m_errorHandle, __TFILE__, __LINE__));
-		m_indicator = ORADATA_OK;
+	case	DT_NUMBER:
+		{
+			int result = OCINumberFromInt ( m_stmt->m_errorHandle, &value, sizeof (__int64), OCI_NUMBER_SIGNED, reinterpret_cast <OCINumber *> (currentBuffer ()));
+			if (result != OCI_SUCCESS)
+				throw (OraError(result, m_stmt->m_errorHandle, __TFILE__, __LINE__));
+		}
+		break;
+
+	case	DT_INT32:
+		if (static_cast <__int64> (static_cast <int> (value)) != value)
+			throw (OraError(EC_BAD_INPUT_TYPE, __TFILE__, __LINE__, m_paramName.c_str ()));
+		*reinterpret_cast <int *> (currentBuffer ()) = static_cast <int> (value);
+		break;
+
+	case	DT_INT64:
+		*reinterpret_cast <__int64 *> (currentBuffer ()) = value;
+		break;
+
+	case	DT_UINT64:
+		if (value < 0)
+			throw (OraError(EC_BAD_INPUT_TYPE, __TFILE__, __LINE__, m_paramName.c_str ()));
+		*reinterpret_cast <unsigned __int64 *> (currentBuffer ()) = static_cast <unsigned __int64> (value);
+		break;
+
+	case	DT_DOUBLE:
+		*reinterpret_cast <double *> (currentBuffer ()) = static_cast <double> (value);
+		break;
+
+	default:
+		throw (OraError(EC_BAD_INPUT_TYPE, __TFILE__, __LINE__));
 	}
-	else
+	m_indicators [m_currentCell] = ORADATA_OK;
+	return (*this);
+}
+
+
+Parameter& Parameter::operator = (unsigned __int64 value)
+{
+	EP_ASSERT (m_stmt);
+
+	switch (m_paramType)
+	{
+	case	DT_NUMBER:
+		{
+			int result = OCINumberFromInt ( m_stmt->m_errorHandle, &value, sizeof (unsigned __int64), OCI_NUMBER_UNSIGNED, reinterpret_cast <OCINumber *> (currentBuffer ()));
+			if (result != OCI_SUCCESS)
+				throw (OraError(result, m_stmt->m_errorHandle, __TFILE__, __LINE__));
+		}
+		break;
+
+	case	DT_UINT64:
+		*reinterpret_cast <unsigned __int64 *> (currentBuffer ()) = value;
+		break;
+
+	case	DT_INT32:
+	case	DT_INT64:
+		// the signed range is checked there
+		if (static_cast <__int64> (value) < 0)
+			throw (OraError(EC_BAD_INPUT_TYPE, __TFILE__, __LINE__, m_paramName.c_str ()));
+		return (*this = static_cast <__int64> (value));
+
+	case	DT_DOUBLE:
+		*reinterpret_cast <double *> (currentBuffer ()) = static_cast <double> (value);
+		break;
+
+	default:
 		throw (OraError(EC_BAD_INPUT_TYPE, __TFILE__, __LINE__));
+	}
+	m_indicators [m_currentCell] = ORADATA_OK;
 	return (*this);
 }
 
@@ -312,8 +494,8 @@ Parameter& Parameter::operator = (const DateTime& dateTime)
 
 	if (m_paramType == DT_DATE)
 	{
-		dateTime.SetOciDate(*reinterpret_cast <OCIDate*> (m_fetchBuffer));
-		m_indicator = ORADATA_OK;
+		dateTime.SetOciDate(*reinterpret_cast <OCIDate*> (currentBuffer ()));
+		m_indicators [m_currentCell] = ORADATA_OK;
 	}
 	else
 		throw (OraError(EC_BAD_INPUT_TYPE, __TFILE__, __LINE__));
@@ -325,46 +507,180 @@ epl::EpTString Parameter::ToString () const
 {
 	EP_ASSERT (m_stmt);
 
-	if (m_paramType == DT_TEXT && m_indicator != ORADATA_NULL) 
-		return epl::EpTString(reinterpret_cast<TCHAR*>(m_fetchBuffer));
+	if (m_paramType == DT_TEXT && m_indicators [m_currentCell] != ORADATA_NULL) 
+		return epl::EpTString(reinterpret_cast<TCHAR*>(currentBuffer ()));
 	else
 		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
 }
 
 
-double Parameter::ToDouble () const
+const TCHAR *Parameter::GetText (unsigned int *retLength) const
 {
 	EP_ASSERT (m_stmt);
 
-	if (m_paramType == DT_NUMBER && m_indicator != ORADATA_NULL) 
+	if (m_paramType == DT_TEXT && m_indicators [m_currentCell] != ORADATA_NULL) 
 	{
-		double	value;
-		int result = OCINumberToReal (m_stmt->m_conn->m_errorHandle, reinterpret_cast <OCINumber *> (m_fetchBuffer), sizeof (double), &value);
-		if (result == OCI_SUCCESS)
-			return (value);
-		else
-			throw (OraError(result, m_stmt->m_conn->m_errorHandle, __TFILE__, __LINE__));
+		const TCHAR *text = reinterpret_cast<TCHAR*>(currentBuffer ());
+		if (retLength)
+		{
+			unsigned int length = m_dataLengths [m_currentCell] / sizeof (TCHAR);
+			if (length > 0 && text [length - 1] == _T('\0'))
+				length--;
+			*retLength = length;
+		}
+		return (text);
 	}
 	else
 		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
 }
 
 
+unsigned int Parameter::CopyTo (TCHAR *buffer, unsigned int capacity) const
+{
+	EP_ASSERT (buffer && capacity > 0);
+
+	unsigned int length;
+	const TCHAR *text = GetText (&length);
+	if (length > capacity - 1)
+		length = capacity - 1;
+	memcpy (buffer, text, length * sizeof (TCHAR));
+	buffer [length] = _T('\0');
+	return (length);
+}
+
+
+double Parameter::ToDouble () const
+{
+	EP_ASSERT (m_stmt);
+
+	if (m_indicators [m_currentCell] == ORADATA_NULL)
+		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+
+	switch (m_paramType)
+	{
+	case	DT_NUMBER:
+		{
+			double	value;
+			int result = OCINumberToReal (m_stmt->m_errorHandle, reinterpret_cast <OCINumber *> (currentBuffer ()), sizeof (double), &value);
+			if (result == OCI_SUCCESS)
+				return (value);
+			else
+				throw (OraError(result, m_stmt->m_errorHandle, __TFILE__, __LINE__));
+		}
+
+	case	DT_DOUBLE:
+		return (*reinterpret_cast <double *> (currentBuffer ()));
+
+	case	DT_INT32:
+		return (static_cast <double> (*reinterpret_cast <int *> (currentBuffer ())));
+
+	case	DT_INT64:
+		return (static_cast <double> (*reinterpret_cast <__int64 *> (currentBuffer ())));
+
+	case	DT_UINT64:
+		return (static_cast <double> (*reinterpret_cast <unsigned __int64 *> (currentBuffer ())));
+
+	default:
+		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+	}
+}
+
+
 long Parameter::ToLong () const
 {
 	EP_ASSERT (m_stmt);
 
-	if (m_paramType == DT_NUMBER && m_indicator != ORADATA_NULL) 
+	if (m_paramType == DT_NUMBER && m_indicators [m_currentCell] != ORADATA_NULL) 
 	{
 		long value;
-		int result = OCINumberToInt ( m_stmt->m_conn->m_errorHandle, reinterpret_cast <OCINumber *> (m_fetchBuffer), sizeof (long), OCI_NUMBER_SIGNED, &value);
+		int result = OCINumberToInt ( m_stmt->m_errorHandle, reinterpret_cast <OCINumber *> (currentBuffer ()), sizeof (long), OCI_NUMBER_SIGNED, &value);
 		if (result == OCI_SUCCESS)
 			return (value);
 		else
-			throw (OraError(result, m_stmt->m_conn->m_errorHandle, __TFILE__, __LINE__));
+			throw (OraError(result, m_stmt->m_errorHandle, __TFILE__, __LINE__));
 	}
-	else
+
+	// a native value must fit
+	__int64 value = ToInt64 ();
+	if (static_cast <__int64> (static_cast <long> (value)) != value)
+		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+	return (static_cast <long> (value));
+}
+
+
+__int64 Parameter::ToInt64 () const
+{
+	EP_ASSERT (m_stmt);
+
+	if (m_indicators [m_currentCell] == ORADATA_NULL)
+		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+
+	switch (m_paramType)
+	{
+	case	DT_NUMBER:
+		{
+			__int64 value;
+			int result = OCINumberToInt ( m_stmt->m_errorHandle, reinterpret_cast <OCINumber *> (currentBuffer ()), sizeof (__int64), OCI_NUMBER_SIGNED, &value);
+			if (result == OCI_SUCCESS)
+				return (value);
+			else
+				throw (OraError(result, m_stmt->m_errorHandle, __TFILE__, __LINE__));
+		}
+
+	case	DT_INT32:
+		return (static_cast <__int64> (*reinterpret_cast <int *> (currentBuffer ())));
+
+	case	DT_INT64:
+		return (*reinterpret_cast <__int64 *> (currentBuffer ()));
+
+	case	DT_UINT64:
+		{
+			unsigned __int64 value = *reinterpret_cast <unsigned __int64 *> (currentBuffer ());
+			if (static_cast <__int64> (value) < 0)
+				throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+			return (static_cast <__int64> (value));
+		}
+
+	default:
+		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+	}
+}
+
+
+unsigned __int64 Parameter::ToUInt64 () const
+{
+	EP_ASSERT (m_stmt);
+
+	if (m_indicators [m_currentCell] == ORADATA_NULL)
 		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+
+	switch (m_paramType)
+	{
+	case	DT_NUMBER:
+		{
+			unsigned __int64 value;
+			int result = OCINumberToInt ( m_stmt->m_errorHandle, reinterpret_cast <OCINumber *> (currentBuffer ()), sizeof (unsigned __int64), OCI_NUMBER_UNSIGNED, &value);
+			if (result == OCI_SUCCESS)
+				return (value);
+			else
+				throw (OraError(result, m_stmt->m_errorHandle, __TFILE__, __LINE__));
+		}
+
+	case	DT_UINT64:
+		return (*reinterpret_cast <unsigned __int64 *> (currentBuffer ()));
+
+	case	DT_INT32:
+	case	DT_INT64:
+		{
+			__int64 value = ToInt64 ();
+			if (value < 0)
+				throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+			return (static_cast <unsigned __int64> (value));
+		}
+
+	default:
+		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
+	}
 }
 
 
@@ -372,8 +688,8 @@ DateTime Parameter::ToDateTime () const
 {
 	EP_ASSERT (m_stmt);
 
-	if (m_paramType == DT_DATE && m_indicator != ORADATA_NULL) 
-		return (DateTime (*reinterpret_cast <OCIDate *> (m_fetchBuffer)));
+	if (m_paramType == DT_DATE && m_indicators [m_currentCell] != ORADATA_NULL) 
+		return (DateTime (*reinterpret_cast <OCIDate *> (currentBuffer ())));
 	else
 		throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__));
 }
@@ -0,0 +1,230 @@
+/*! 
+OracleDB Query Job for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epQueryJob.h"
+#include "epConnection.h"
+#include "epStatement.h"
+#include "epParameter.h"
+#include "epResultSet.h"
+#include "epOraError.h"
+#include "epAsyncExecutor.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+QueryJob::QueryJob (const TCHAR *sqlStmt, epl::Priority priority, QueryCallback *callback, ExecuteModesEnum executeMode) :BaseJob(priority), m_doneEvent(false,true)
+{
+	EP_ASSERT (sqlStmt);
+
+	m_sqlStmt = sqlStmt;
+	m_callback = callback;
+	m_executeMode = executeMode;
+	m_executor = NULL;
+	m_error = NULL;
+	m_rowCount = 0;
+	m_isDone = false;
+}
+
+
+QueryJob::~QueryJob ()
+{
+	if (m_error)
+		EP_DELETE m_error;
+	m_error = NULL;
+}
+
+
+QueryJob::BindValue &QueryJob::addBind (const TCHAR *name, DataTypesEnum type)
+{
+	EP_ASSERT (name && !m_isDone);
+
+	BindValue value;
+	value.m_name = name;
+	value.m_type = type;
+	value.m_number = 0.0;
+	value.m_integer = 0;
+	value.m_isNull = false;
+	m_binds.push_back (value);
+	return m_binds.back ();
+}
+
+
+QueryJob &QueryJob::Bind (const TCHAR *name, const TCHAR *text)
+{
+	EP_ASSERT (text);
+	addBind (name, DT_TEXT).m_text = text;
+	return *this;
+}
+
+
+QueryJob &QueryJob::Bind (const TCHAR *name, double value)
+{
+	addBind (name, DT_NUMBER).m_number = value;
+	return *this;
+}
+
+
+QueryJob &QueryJob::Bind (const TCHAR *name, long value)
+{
+	addBind (name, DT_NUMBER).m_number = static_cast <double> (value);
+	return *this;
+}
+
+
+QueryJob &QueryJob::Bind (const TCHAR *name, __int64 value)
+{
+	addBind (name, DT_INT64).m_integer = value;
+	return *this;
+}
+
+
+QueryJob &QueryJob::Bind (const TCHAR *name, const DateTime &dateTime)
+{
+	addBind (name, DT_DATE).m_dateTime = dateTime;
+	return *this;
+}
+
+
+QueryJob &QueryJob::BindNull (const TCHAR *name, DataTypesEnum type)
+{
+	addBind (name, type).m_isNull = true;
+	return *this;
+}
+
+
+bool QueryJob::Wait (unsigned int waitTimeInMilliSec)
+{
+	if (!m_isDone && !m_doneEvent.WaitForEvent (waitTimeInMilliSec))
+		return (false);
+	if (m_error)
+		throw (OraError(*m_error));
+	return (true);
+}
+
+
+void QueryJob::run (Connection &conn)
+{
+	try
+	{
+		Statement *statement = conn.Prepare (m_sqlStmt.c_str ());
+		try
+		{
+			for (std::vector <BindValue>::iterator i = m_binds.begin (); i != m_binds.end (); ++i)
+			{
+				unsigned int maxTextLength = 0;
+				if (i->m_type == DT_TEXT && (i->m_text.length () + 1) * sizeof (TCHAR) > MAX_OUTPUT_TEXT_BYTES)
+					maxTextLength = static_cast <unsigned int> (i->m_text.length ());
+
+				Parameter &param = statement->Bind (i->m_name.c_str (), i->m_type, 1, maxTextLength);
+				if (i->m_isNull)
+					param.ToNull ();
+				else if (i->m_type == DT_TEXT)
+					param = i->m_text;
+				else if (i->m_type == DT_NUMBER)
+					param = i->m_number;
+				else if (i->m_type == DT_INT64)
+					param = i->m_integer;
+				else if (i->m_type == DT_DATE)
+					param = i->m_dateTime;
+			}
+
+			if (statement->GetStmtType () == ST_SELECT)
+			{
+				ResultSet *resultSet = statement->Select ();
+				try
+				{
+					if (m_callback)
+						m_callback->OnResultSet (*this, *resultSet);
+					m_rowCount = resultSet->GetRowsFetched ();
+				}
+				catch (...)
+				{
+					resultSet->ReleaseObj ();
+					throw;
+				}
+				resultSet->ReleaseObj ();
+			}
+			else
+			{
+				statement->Execute (1, m_executeMode);
+				m_rowCount = statement->GetRowCount ();
+			}
+		}
+		catch (...)
+		{
+			statement->ReleaseObj ();
+			throw;
+		}
+		statement->ReleaseObj ();
+	}
+	catch (OraError &error)
+	{
+		m_error = EP_NEW OraError(error);
+	}
+	catch (...)
+	{
+		m_error = EP_NEW OraError(EC_INTERNAL, __TFILE__, __LINE__);
+	}
+	finish ();
+}
+
+
+void QueryJob::finish ()
+{
+	m_isDone = true;
+	if (m_callback)
+	{
+		try
+		{
+			m_callback->OnComplete (*this);
+		}
+		catch (...)
+		{
+			// the delegate must not stop the worker
+		}
+	}
+	m_doneEvent.SetEvent ();
+}
+
+
+void QueryJob::handleReport (const JobStatus status)
+{
+	// dropped from the queue without being run
+	if ((status == JOB_STATUS_INCOMPLETE || status == JOB_STATUS_TIMEOUT) && !m_isDone)
+	{
+		m_error = EP_NEW OraError(EC_INTERNAL, __TFILE__, __LINE__, _T("the job was not run"));
+		finish ();
+
+		// the job may be deleted from here on
+		if (m_executor)
+			m_executor->jobDone (this);
+	}
+}
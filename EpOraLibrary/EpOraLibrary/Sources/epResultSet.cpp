@@ -27,6 +27,9 @@ THE SOFTWARE.
 #include "epColumn.h"
 #include "epOraError.h"
 #include "epConnection.h"
+#include "epFetchWorker.h"
+#include "epAsyncOperation.h"
+#include "epAsyncReactor.h"
 
 #if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 #define new DEBUG_NEW
@@ -37,12 +40,12 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epol;
 
-ResultSet::ResultSet (OCIStmt *rs, Connection *useConnection,unsigned int fetchSize):SmartObject()
+ResultSet::ResultSet (OCIStmt *rs, Connection *useConnection,unsigned int fetchSize, FetchModesEnum fetchMode):SmartObject()
 {
 	initialize ();
 	try
 	{
-		attach (rs,	useConnection, fetchSize);
+		attach (rs,	useConnection, fetchSize, fetchMode);
 	}
 	catch (...)
 	{
@@ -62,46 +65,85 @@ void ResultSet::initialize ()
 {
 	m_conn = NULL;
 	m_rsHandle = NULL;
+	m_errorHandle = NULL;
 	m_stmt = NULL;
 	m_fetchCount = 0;
 	m_rowsFetched = 0;
 	m_currentRow = 0;
+	m_arrayStartRow = 0;
 	m_isEod = false;
+	m_isRowConsumed = false;
+	m_batchStart = 0;
+	m_batchSize = 0;
 	m_isDescribed = false;
 	m_isDefined = false;
+	m_fetchMode = FM_DEFAULT;
+	m_frontSet = 0;
+	m_fetchWorker = NULL;
+	m_arena = NULL;
+	m_arenaBytes = 0;
 }
 
 
 void ResultSet::cleanUp ()
 {
+	if (m_fetchWorker)
+		EP_DELETE m_fetchWorker;
+	m_fetchWorker = NULL;
+
 	for (Columns::iterator i=m_columns.begin (); i!=m_columns.end (); ++i)
 		(*i)->ReleaseObj();
 	m_columns.clear ();
+	m_columnSlots.clear ();
+
+	// the buffers of all columns go back at once, for the next result set of the same shape
+	if (m_arena)
+		m_conn->returnArena (m_arena, m_arenaBytes);
+	m_arena = NULL;
+	m_arenaBytes = 0;
 
 	if (m_rsHandle) 
 		m_rsHandle = NULL;
 
+	if (m_errorHandle)
+		OCIHandleFree (m_errorHandle, OCI_HTYPE_ERROR);
+	m_errorHandle = NULL;
+
 	if (m_stmt) 
 		m_stmt->ReleaseObj();
 	m_stmt = NULL;
 }
 
 
-void ResultSet::attach (OCIStmt *rs,Connection *useConnection,unsigned int fetchSize)	// = FETCH_SIZE
+void ResultSet::attach (OCIStmt *rs,Connection *useConnection,unsigned int fetchSize, FetchModesEnum fetchMode)	// = 0, = FM_DEFAULT
 {
 	m_conn = useConnection;
 	m_rsHandle = rs;
 	m_stmt = NULL;
 	m_fetchCount = fetchSize;
+	m_fetchMode = fetchMode;
+	m_frontSet = 0;
 
 	m_rowsFetched = 0;
 	m_currentRow = 0;
+	m_arrayStartRow = 0;
 	m_isEod = false;
+	m_isRowConsumed = false;
+	m_batchStart = 0;
+	m_batchSize = 0;
 
 	m_isDescribed = false;
 	m_isDefined = false;
 
+	int result = OCIHandleAlloc (m_conn->m_envHandle, (void **) &m_errorHandle, OCI_HTYPE_ERROR, 0, NULL);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_conn->m_envHandle, __TFILE__, __LINE__));
+
 	describe ();
+	// rows are defined on caller's structures by BindRows
+	if (m_fetchMode == FM_BOUND_ROWS)
+		return;
+	allocateBuffers ();
 	define ();
 }
 
@@ -112,28 +154,11 @@ unsigned int ResultSet::columnsCount ()
 	unsigned int count;
 
 	count = 0;
-	result = OCIAttrGet (m_rsHandle, OCI_HTYPE_STMT, &count, NULL, OCI_ATTR_PARAM_COUNT, m_conn->m_errorHandle);
+	result = OCIAttrGet (m_rsHandle, OCI_HTYPE_STMT, &count, NULL, OCI_ATTR_PARAM_COUNT, m_errorHandle);
 	if (result == OCI_SUCCESS)
 		return (count);
 	else
-		throw (OraError(result, m_conn->m_errorHandle, __TFILE__, __LINE__));
-}
-
-
-unsigned int ResultSet::rowsCount ()
-{
-	int	result;
-	unsigned int		count;
-
-	count = 0;
-	result = OCIAttrGet (m_rsHandle, OCI_HTYPE_STMT, &count, NULL, OCI_ATTR_ROW_COUNT, m_conn->m_errorHandle);
-	if (result == OCI_SUCCESS)
-	{
-		m_nTotRow += count;
-		return (count);
-	}
-	else
-		throw (OraError(result, m_conn->m_errorHandle, __TFILE__, __LINE__));
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
 }
 
 
@@ -151,42 +176,106 @@ void ResultSet::describe ()
 		unsigned int nameLen = 0;
 		unsigned short ociType = 0;
 		unsigned short size = 0;
+		short precision = 0;
+		signed char scale = 0;
 
-		result = OCIParamGet ( m_rsHandle, OCI_HTYPE_STMT, m_conn->m_errorHandle, reinterpret_cast <void **> (&paramHandle),i + 1);
+		result = OCIParamGet ( m_rsHandle, OCI_HTYPE_STMT, m_errorHandle, reinterpret_cast <void **> (&paramHandle),i + 1);
 
 		if (result == OCI_SUCCESS)
 		{
-			result = OCIAttrGet (paramHandle, OCI_DTYPE_PARAM, &paramName, &nameLen, OCI_ATTR_NAME, m_conn->m_errorHandle);
+			result = OCIAttrGet (paramHandle, OCI_DTYPE_PARAM, &paramName, &nameLen, OCI_ATTR_NAME, m_errorHandle);
 		}
 
 		if (result == OCI_SUCCESS)
 		{
-			result = OCIAttrGet (paramHandle, OCI_DTYPE_PARAM, &ociType, NULL, OCI_ATTR_DATA_TYPE, m_conn->m_errorHandle);
+			result = OCIAttrGet (paramHandle, OCI_DTYPE_PARAM, &ociType, NULL, OCI_ATTR_DATA_TYPE, m_errorHandle);
 		}
 
 		if (result == OCI_SUCCESS)
 		{
-			result = OCIAttrGet (paramHandle, OCI_DTYPE_PARAM, &size, NULL, OCI_ATTR_DATA_SIZE, m_conn->m_errorHandle);
+			result = OCIAttrGet (paramHandle, OCI_DTYPE_PARAM, &size, NULL, OCI_ATTR_DATA_SIZE, m_errorHandle);
+		}
+
+		if (result == OCI_SUCCESS && ociType == SQLT_NUM)
+		{
+			result = OCIAttrGet (paramHandle, OCI_DTYPE_PARAM, &precision, NULL, OCI_ATTR_PRECISION, m_errorHandle);
+			if (result == OCI_SUCCESS)
+				result = OCIAttrGet (paramHandle, OCI_DTYPE_PARAM, &scale, NULL, OCI_ATTR_SCALE, m_errorHandle);
 		}
 
 		if (paramHandle)
 			OCIDescriptorFree ( paramHandle, OCI_DTYPE_PARAM);
 
 		if (result != OCI_SUCCESS)
-			throw (OraError(result, m_conn->m_errorHandle, __TFILE__, __LINE__));
+			throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
 
-		Column	*col = EP_NEW Column (this, reinterpret_cast <const TCHAR *> (paramName), ociType, size, m_fetchCount);
+		Column	*col = EP_NEW Column (this, reinterpret_cast <const TCHAR *> (paramName), ociType, size, precision, scale);
 
 		m_columns.push_back (col);
-		m_columnsMap [col->m_colName] = col;
 	}
+	buildColumnIndex ();
 
 	m_isDescribed = true;
 	m_isDefined = false;
 }
 
 
+void ResultSet::allocateBuffers ()
+{
+	EP_ASSERT (m_isDescribed);
+
+	Columns::iterator	i;
+	unsigned int bufferSets = (m_fetchMode == FM_PIPELINED) ? 2 : 1;
+
+	if (m_fetchCount == 0)
+	{
+		unsigned int rowBytes = 0;
+		for (i=m_columns.begin (); i!=m_columns.end (); ++i)
+			rowBytes += (*i)->getRowBytes ();
+
+		unsigned int fetchCount = FETCH_SIZE;
+		if (rowBytes > 0)
+			fetchCount = m_conn->m_fetchMemoryBudget / (rowBytes * bufferSets);
+		if (fetchCount < 1)
+			fetchCount = 1;
+		if (fetchCount > FETCH_SIZE)
+			fetchCount = FETCH_SIZE;
+		m_fetchCount = fetchCount;
+	}
+
+	// lay out the buffers of all columns in a single block
+	size_t arenaBytes = 0;
+	for (i=m_columns.begin (); i!=m_columns.end (); ++i)
+		arenaBytes += (*i)->getArenaBytes (m_fetchCount, bufferSets);
+
+	EP_ASSERT (!m_arena);
+	m_arenaBytes = arenaBytes + CACHE_LINE_SIZE;
+	m_arena = m_conn->borrowArena (m_arenaBytes);
+	if (!m_arena)
+		m_arena = EP_NEW char [m_arenaBytes];
+	if (!m_arena)
+		throw (OraError(EC_NO_MEMORY, __TFILE__, __LINE__));
+
+	char *arena = reinterpret_cast <char *> (ALIGN_TO_CACHE_LINE (reinterpret_cast <size_t> (m_arena)));
+	for (i=m_columns.begin (); i!=m_columns.end (); ++i)
+	{
+		(*i)->allocate (m_fetchCount, bufferSets, arena);
+		arena += (*i)->getArenaBytes (m_fetchCount, bufferSets);
+	}
+}
+
+
 void ResultSet::define()
+{
+	Column *failedColumn = NULL;
+	int result = defineBufferSet (m_frontSet, m_errorHandle, &failedColumn);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__, failedColumn->m_colName.c_str ()));
+	m_isDefined = true;
+}
+
+
+int ResultSet::defineBufferSet (unsigned int bufferSet, OCIError *errorHandle, Column **retColumn)
 {
 	Columns::iterator	i;
 	int	result;
@@ -196,24 +285,86 @@ void ResultSet::define()
 	result = OCI_SUCCESS;
 	for (i=m_columns.begin (); result == OCI_SUCCESS && i!=m_columns.end (); ++i)
 	{
-		result = OCIDefineByPos (m_rsHandle, &((*i)->m_defineHandle), m_conn->m_errorHandle, position++, (*i)->m_fetchBuffer, (*i)->m_size,	(*i)->m_ociType, (*i)->m_indicators, (*i)->m_dataLengths, NULL, OCI_DEFAULT);
+		result = OCIDefineByPos (m_rsHandle, &((*i)->m_defineHandle), errorHandle, position++, (*i)->m_fetchBufferSets[bufferSet], (*i)->m_size,	(*i)->m_ociType, (*i)->m_indicatorSets[bufferSet], (*i)->m_dataLengthSets[bufferSet], NULL, OCI_DEFAULT);
 
 #if defined(_UNICODE) || defined(UNICODE)
 		if (result == OCI_SUCCESS && (*i)->m_colType == DT_TEXT)
 		{
 
 			unsigned int value = OCI_UTF16ID;
-			result = OCIAttrSet ( (*i)->m_defineHandle, OCI_HTYPE_DEFINE, &value, sizeof (value), OCI_ATTR_CHARSET_ID, m_conn->m_errorHandle);
+			result = OCIAttrSet ( (*i)->m_defineHandle, OCI_HTYPE_DEFINE, &value, sizeof (value), OCI_ATTR_CHARSET_ID, errorHandle);
 		}
 #endif //defined(_UNICODE) || defined(UNICODE)
 
+		if (result != OCI_SUCCESS && retColumn)
+			*retColumn = *i;
+	}
+	return (result);
+}
+
+
+void ResultSet::bindRows (const std::vector <RowFieldDefine> &defines, unsigned int rowSize, unsigned int capacity)
+{
+	EP_ASSERT (m_isDescribed);
+
+	if (m_fetchMode != FM_BOUND_ROWS)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__));
+	if (defines.size () != m_columns.size ())
+		throw (OraError(EC_COLUMN_NOT_FOUND, __TFILE__, __LINE__, _T("%d fields mapped for %d columns"), (int) defines.size (), (int) m_columns.size ()));
+
+	int	result = OCI_SUCCESS;
+	m_isDefined = false;
+	for (unsigned int position = 0; position < m_columns.size (); position++)
+	{
+		const RowFieldDefine &field = defines [position];
+		Column *col = m_columns [position];
+		if (field.m_colType != col->m_colType)
+			throw (OraError(EC_BAD_OUTPUT_TYPE, __TFILE__, __LINE__, col->m_colName.c_str ()));
+
+		result = OCIDefineByPos (m_rsHandle, &(col->m_defineHandle), m_errorHandle, position + 1, field.m_address, field.m_size, field.m_ociType, field.m_indicator, NULL, NULL, OCI_DEFAULT);
+
+#if defined(_UNICODE) || defined(UNICODE)
+		if (result == OCI_SUCCESS && col->m_colType == DT_TEXT)
+		{
+			unsigned int value = OCI_UTF16ID;
+			result = OCIAttrSet (col->m_defineHandle, OCI_HTYPE_DEFINE, &value, sizeof (value), OCI_ATTR_CHARSET_ID, m_errorHandle);
+		}
+#endif //defined(_UNICODE) || defined(UNICODE)
+
+		if (result == OCI_SUCCESS)
+			result = OCIDefineArrayOfStruct (col->m_defineHandle, m_errorHandle, rowSize, field.m_indicator ? rowSize : 0, 0, 0);
+
 		if (result != OCI_SUCCESS)
-			throw (OraError(result, m_conn->m_errorHandle, __TFILE__, __LINE__, (*i)->m_colName.c_str ()));
+			throw (OraError(result, m_errorHandle, __TFILE__, __LINE__, col->m_colName.c_str ()));
 	}
+	m_fetchCount = capacity;
 	m_isDefined = true;
 }
 
 
+unsigned int ResultSet::FetchBoundRows ()
+{
+	EP_ASSERT (m_isDescribed);
+
+	if (m_fetchMode != FM_BOUND_ROWS || !m_isDefined)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__));
+	if (m_isEod)
+		return (0);
+
+	unsigned int fetched = 0;
+	int result = fetchArray (0, m_errorHandle, fetched);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
+
+	m_arrayStartRow = m_rowsFetched;
+	m_rowsFetched += fetched;
+	m_currentRow = m_rowsFetched;
+	if (fetched != m_fetchCount)
+		m_isEod = true;
+	return (fetched);
+}
+
+
 void ResultSet::attachStatement (Statement *selectStmt)
 {
 	EP_ASSERT (selectStmt);
@@ -223,21 +374,145 @@ void ResultSet::attachStatement (Statement *selectStmt)
 
 
 void ResultSet::fetchRows ()
+{
+	OCIError *errorHandle = NULL;
+	int result = tryFetchRows (errorHandle);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, errorHandle, __TFILE__, __LINE__));
+}
+
+
+int ResultSet::tryFetchRows (OCIError *&retErrorHandle)
 {
 	EP_ASSERT (m_isDescribed && m_isDefined);
 
 	int	result;
-	unsigned int oldRowsCount = m_rowsFetched;
+	unsigned int fetched = 0;
+	OCIError *errorHandle = m_errorHandle;
 
-	result = OCIStmtFetch (m_rsHandle, m_conn->m_errorHandle, m_fetchCount, OCI_FETCH_NEXT, OCI_DEFAULT);
-	if (result == OCI_SUCCESS || result == OCI_NO_DATA || result == OCI_SUCCESS_WITH_INFO)
+	if (m_fetchWorker)
 	{
-		m_rowsFetched = rowsCount ();
-		if (m_rowsFetched - oldRowsCount != m_fetchCount)
-			m_isEod = true;
+		// the block was fetched in background into the back buffer set
+		errorHandle = m_fetchWorker->GetErrorHandle ();
+		result = m_fetchWorker->Wait ();
+		fetched = m_fetchWorker->GetRowsFetched ();
+		if (result == OCI_SUCCESS)
+		{
+			m_frontSet ^= 1;
+			for (Columns::iterator i=m_columns.begin (); i!=m_columns.end (); ++i)
+				(*i)->selectBufferSet (m_frontSet);
+		}
 	}
 	else
-		throw (OraError(result, m_conn->m_errorHandle, __TFILE__, __LINE__));
+		result = fetchArray (m_frontSet, errorHandle, fetched);
+
+	// a failed block is not requested again, so the later calls report the same error
+	retErrorHandle = errorHandle;
+	if (result != OCI_SUCCESS)
+		return (result);
+
+	m_arrayStartRow = m_rowsFetched;
+	m_rowsFetched += fetched;
+	if (fetched != m_fetchCount)
+		m_isEod = true;
+
+	if (m_fetchMode == FM_PIPELINED && !m_isEod)
+	{
+		if (!m_fetchWorker)
+			m_fetchWorker = EP_NEW FetchWorker (this);
+		m_fetchWorker->Request (m_frontSet ^ 1);
+	}
+	return (result);
+}
+
+
+int ResultSet::fetchArray (unsigned int bufferSet, OCIError *errorHandle, unsigned int &retRowsFetched)
+{
+	int	result = OCI_SUCCESS;
+
+	// buffer sets take turns, so the one to fill has to be bound again
+	if (m_fetchMode == FM_PIPELINED)
+		result = defineBufferSet (bufferSet, errorHandle, NULL);
+
+	// a non-blocking connection returns OCI_STILL_EXECUTING until the call completes
+	if (result == OCI_SUCCESS)
+	{
+		result = fetchStep (errorHandle);
+		while (result == OCI_STILL_EXECUTING)
+		{
+			Sleep (ASYNC_REACTOR_POLL_INTERVAL);
+			result = fetchStep (errorHandle);
+		}
+		result = rowsFetched (result, errorHandle, retRowsFetched);
+	}
+	return (result);
+}
+
+
+int ResultSet::fetchStep (OCIError *errorHandle)
+{
+	return (OCIStmtFetch (m_rsHandle, errorHandle, m_fetchCount, OCI_FETCH_NEXT, OCI_DEFAULT));
+}
+
+
+int ResultSet::fetchAsyncStep ()
+{
+	return (fetchStep (m_errorHandle));
+}
+
+
+int ResultSet::rowsFetched (int result, OCIError *errorHandle, unsigned int &retRowsFetched)
+{
+	if (result == OCI_SUCCESS || result == OCI_NO_DATA || result == OCI_SUCCESS_WITH_INFO)
+	{
+		retRowsFetched = 0;
+		result = OCIAttrGet (m_rsHandle, OCI_HTYPE_STMT, &retRowsFetched, NULL, OCI_ATTR_ROWS_FETCHED, errorHandle);
+	}
+	return (result);
+}
+
+
+AsyncOperation *ResultSet::FetchAsync (AsyncReactor &reactor)
+{
+	EP_ASSERT (m_isDescribed);
+
+	if (m_fetchMode == FM_PIPELINED || !m_isDefined)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__));
+
+	FetchOperation *operation = EP_NEW FetchOperation (this);
+	try
+	{
+		if (!operation->IsDone ())
+			reactor.submit (operation);
+	}
+	catch (...)
+	{
+		operation->ReleaseObj ();
+		throw;
+	}
+	return (operation);
+}
+
+
+unsigned int ResultSet::endFetch (int result)
+{
+	unsigned int fetched = 0;
+
+	result = rowsFetched (result, m_errorHandle, fetched);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
+
+	m_arrayStartRow = m_rowsFetched;
+	m_rowsFetched += fetched;
+	if (fetched != m_fetchCount)
+		m_isEod = true;
+
+	// bound rows are handed out as a whole
+	m_currentRow = (m_fetchMode == FM_BOUND_ROWS) ? m_rowsFetched : m_arrayStartRow;
+	m_isRowConsumed = false;
+	m_batchStart = 0;
+	m_batchSize = 0;
+	return (fetched);
 }
 
 
@@ -245,7 +520,67 @@ bool ResultSet::Next ()
 {
 	EP_ASSERT (m_isDescribed && m_isDefined);
 
+	if (m_fetchMode == FM_BOUND_ROWS)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__));
+
+	m_currentRow++;
+	m_isRowConsumed = false;
+	// a batch ends with the traversal by row
+	m_batchStart = 0;
+	m_batchSize = 0;
+	if (m_currentRow >= m_rowsFetched)
+		if (!m_isEod)
+			fetchRows();
+		else
+			return (false);
+	if (m_currentRow >= m_rowsFetched)
+		return (false);
+
+	return (true);
+}
+
+
+Status ResultSet::TryNext ()
+{
+	EP_ASSERT (m_isDescribed && m_isDefined);
+
+	if (m_fetchMode == FM_BOUND_ROWS)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__));
+
 	m_currentRow++;
+	m_isRowConsumed = false;
+	// a batch ends with the traversal by row
+	m_batchStart = 0;
+	m_batchSize = 0;
+	if (m_currentRow >= m_rowsFetched && !m_isEod)
+	{
+		OCIError *errorHandle = NULL;
+		int result = tryFetchRows (errorHandle);
+		if (result != OCI_SUCCESS)
+			return (Status(result, errorHandle));
+	}
+
+	Status status;
+	if (m_currentRow >= m_rowsFetched)
+		status = Status(OCI_NO_DATA, NULL);
+	status.m_rowCount = m_rowsFetched;
+	return (status);
+}
+
+
+bool ResultSet::NextBatch ()
+{
+	EP_ASSERT (m_isDescribed && m_isDefined);
+
+	if (m_fetchMode == FM_BOUND_ROWS)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__));
+
+	// the current row was handed out with the previous batch
+	if (m_isRowConsumed)
+		m_currentRow++;
+	m_isRowConsumed = false;
+	m_batchSize = 0;
+
 	if (m_currentRow >= m_rowsFetched)
 		if (!m_isEod)
 			fetchRows();
@@ -254,18 +589,107 @@ bool ResultSet::Next ()
 	if (m_currentRow >= m_rowsFetched)
 		return (false);
 
+	m_batchStart = currentSlot ();
+	m_batchSize = static_cast <unsigned int> (m_rowsFetched - m_currentRow);
+	m_currentRow = m_rowsFetched - 1;
+	m_isRowConsumed = true;
 	return (true);
 }
 
 
+unsigned int ResultSet::columnSlot () const
+{
+	if (m_fetchMode == FM_BOUND_ROWS)
+		throw (OraError(EC_BAD_FETCH_MODE, __TFILE__, __LINE__, _T("the rows are fetched into the bound buffers")));
+	return (currentSlot ());
+}
+
+
 Column& ResultSet::operator [] (const TCHAR *columnName)
 {
-	epl::EpTString scolumn_name(columnName);
-	scolumn_name=epl::Locale::ToUpper(scolumn_name);
-	ColumnsMap::iterator i = m_columnsMap.find (scolumn_name.c_str());
-	if (i == m_columnsMap.end ())
+	int position = findColumn (columnName);
+	if (position < 0)
 		throw (OraError(EC_COLUMN_NOT_FOUND, __TFILE__, __LINE__, columnName));
-	return (*(i->second));
+	return (*(m_columns [position]));
+}
+
+
+unsigned short ResultSet::ColumnIndex (const TCHAR *columnName) const
+{
+	int position = findColumn (columnName);
+	if (position < 0)
+		throw (OraError(EC_COLUMN_NOT_FOUND, __TFILE__, __LINE__, columnName));
+	return (static_cast <unsigned short> (position + FIRST_COLUMN_NO));
+}
+
+
+unsigned int ResultSet::hashColumnName (const TCHAR *columnName)
+{
+	// FNV-1a over the ASCII upper-cased characters
+	unsigned int hash = 2166136261U;
+	for (; *columnName; columnName++)
+	{
+		TCHAR ch = *columnName;
+		if (ch >= _T('a') && ch <= _T('z'))
+			ch = ch - _T('a') + _T('A');
+		hash = (hash ^ static_cast <unsigned int> (ch)) * 16777619U;
+	}
+	return (hash);
+}
+
+
+bool ResultSet::equalColumnNames (const TCHAR *name1, const TCHAR *name2)
+{
+	for (; *name1 && *name2; name1++, name2++)
+	{
+		TCHAR ch1 = *name1, ch2 = *name2;
+		if (ch1 >= _T('a') && ch1 <= _T('z'))
+			ch1 = ch1 - _T('a') + _T('A');
+		if (ch2 >= _T('a') && ch2 <= _T('z'))
+			ch2 = ch2 - _T('a') + _T('A');
+		if (ch1 != ch2)
+			return (false);
+	}
+	return (*name1 == *name2);
+}
+
+
+void ResultSet::buildColumnIndex ()
+{
+	// power of two with load factor at most 1/2
+	unsigned int slotCount = 8;
+	while (slotCount < m_columns.size () * 2)
+		slotCount <<= 1;
+	m_columnSlots.assign (slotCount, 0);
+
+	unsigned int mask = slotCount - 1;
+	for (unsigned int position = 0; position < m_columns.size (); position++)
+	{
+		const TCHAR *name = m_columns [position]->m_colName.c_str ();
+		unsigned int slot = hashColumnName (name) & mask;
+		// a later column with the same name replaces the earlier one
+		while (m_columnSlots [slot] && !equalColumnNames (m_columns [m_columnSlots [slot] - 1]->m_colName.c_str (), name))
+			slot = (slot + 1) & mask;
+		m_columnSlots [slot] = static_cast <unsigned short> (position + 1);
+	}
+}
+
+
+int ResultSet::findColumn (const TCHAR *columnName) const
+{
+	if (m_columnSlots.empty ())
+		return (-1);
+
+	unsigned int mask = static_cast <unsigned int> (m_columnSlots.size ()) - 1;
+	unsigned int slot = hashColumnName (columnName) & mask;
+	while (m_columnSlots [slot])
+	{
+		int position = m_columnSlots [slot] - 1;
+		if (equalColumnNames (m_columns [position]->m_colName.c_str (), columnName))
+			return (position);
+		slot = (slot + 1) & mask;
+	}
+	return (-1);
 }
 
 
@@ -0,0 +1,262 @@
+/*! 
+OracleDB Session Pool for the EpOraLibrary
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epSessionPool.h"
+#include "epConnection.h"
+#include "epOraError.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+
+using namespace epol;
+
+/// ORA-24418: Cannot open further sessions
+#define ORA_POOL_NO_MORE_SESSIONS 24418
+/// ORA-24496: OCISessionGet() timed out waiting for a free connection
+#define ORA_POOL_GET_TIMED_OUT 24496
+
+
+SessionPool::SessionPool (Environment &environment) :SmartObject(), m_returnEvent(false,false)
+{
+	m_environment = &environment;
+	m_environment->RetainObj ();
+	initialize ();
+}
+
+
+SessionPool::SessionPool (Environment &environment, const TCHAR *serviceName, const TCHAR *loginID, const TCHAR *password, unsigned int sessionMin, unsigned int sessionMax, unsigned int sessionIncrement, unsigned int getTimeout, unsigned int idleTimeout) :SmartObject(), m_returnEvent(false,false)
+{
+	m_environment = &environment;
+	m_environment->RetainObj ();
+	initialize ();
+	try
+	{
+		Create (serviceName, loginID, password, sessionMin, sessionMax, sessionIncrement, getTimeout, idleTimeout);
+	}
+	catch (...)
+	{
+		Destroy ();
+		m_environment->ReleaseObj ();
+		throw;
+	}
+}
+
+
+SessionPool::~SessionPool ()
+{
+	try
+	{
+		Destroy ();
+	}
+	catch (...)
+	{
+		// the sessions are closed with the environment anyway
+	}
+	m_environment->ReleaseObj ();
+}
+
+
+void SessionPool::initialize ()
+{
+	m_poolHandle = NULL;
+	m_errorHandle = NULL;
+	m_poolName = NULL;
+	m_poolNameLength = 0;
+	m_sessionMax = 0;
+	m_getTimeout = WAITTIME_INIFINITE;
+	m_isCreated = false;
+	memset (&m_statistics, 0, sizeof (m_statistics));
+}
+
+
+void SessionPool::Create (const TCHAR *serviceName, const TCHAR *loginID, const TCHAR *password, unsigned int sessionMin, unsigned int sessionMax, unsigned int sessionIncrement, unsigned int getTimeout, unsigned int idleTimeout)
+{
+	EP_ASSERT (serviceName && loginID && password);
+	EP_ASSERT (sessionMax > 0 && sessionMin <= sessionMax);
+	EP_ASSERT (!m_isCreated);
+
+	OCIEnv *envHandle = m_environment->GetHandle ();
+	int	result;
+
+	// allocate a pool handle
+	result = OCIHandleAlloc (envHandle, (void **) &m_poolHandle, OCI_HTYPE_SPOOL, 0, NULL);
+
+	// allocate an error handle
+	if (result == OCI_SUCCESS)
+		result = OCIHandleAlloc (envHandle, (void **) &m_errorHandle, OCI_HTYPE_ERROR, 0, NULL);
+
+	// create the sessions, all logged on with the same user
+	if (result == OCI_SUCCESS)
+	{
+		ub4 poolNameLength = 0;
+		result = OCISessionPoolCreate (envHandle, m_errorHandle, m_poolHandle, &m_poolName, &poolNameLength,
+			(const OraText *) serviceName, epl::System::TcsLen (serviceName)*sizeof(TCHAR), sessionMin, sessionMax, sessionIncrement,
+			(OraText *) loginID, epl::System::TcsLen (loginID)*sizeof(TCHAR), (OraText *) password, epl::System::TcsLen (password)*sizeof(TCHAR), OCI_SPC_HOMOGENEOUS);
+		m_poolNameLength = poolNameLength;
+	}
+	else
+		throw (OraError(result, envHandle, __TFILE__, __LINE__));
+
+	// a finite get timeout is waited by the library, so OCI must not block
+	if (result == OCI_SUCCESS)
+	{
+		ub1 getMode = (getTimeout == WAITTIME_INIFINITE) ? OCI_SPOOL_ATTRVAL_WAIT : OCI_SPOOL_ATTRVAL_NOWAIT;
+		result = OCIAttrSet (m_poolHandle, OCI_HTYPE_SPOOL, &getMode, sizeof (getMode), OCI_ATTR_SPOOL_GETMODE, m_errorHandle);
+	}
+
+	if (result == OCI_SUCCESS && idleTimeout > 0)
+	{
+		ub4 timeout = idleTimeout;
+		result = OCIAttrSet (m_poolHandle, OCI_HTYPE_SPOOL, &timeout, sizeof (timeout), OCI_ATTR_SPOOL_TIMEOUT, m_errorHandle);
+	}
+
+	if (result == OCI_SUCCESS)
+	{
+		m_sessionMax = sessionMax;
+		m_getTimeout = getTimeout;
+		m_isCreated = true;
+	}
+	else
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
+}
+
+
+void SessionPool::Destroy ()
+{
+	int result = OCI_SUCCESS;
+
+	if (m_isCreated)
+		result = OCISessionPoolDestroy (m_poolHandle, m_errorHandle, OCI_DEFAULT);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
+	m_isCreated = false;
+
+	if (m_errorHandle)
+		OCIHandleFree (m_errorHandle, OCI_HTYPE_ERROR);
+	if (m_poolHandle)
+		OCIHandleFree (m_poolHandle, OCI_HTYPE_SPOOL);
+	initialize ();
+}
+
+
+Connection *SessionPool::Borrow ()
+{
+	return EP_NEW Connection (*this);
+}
+
+
+void SessionPool::Return (Connection *connection)
+{
+	EP_ASSERT (connection);
+	EP_DELETE connection;
+}
+
+
+SessionPoolStatistics SessionPool::GetStatistics () const
+{
+	epl::LockObj lock (&m_statLock);
+	SessionPoolStatistics statistics = m_statistics;
+
+	if (m_isCreated)
+	{
+		ub4 count = 0;
+		if (OCIAttrGet (m_poolHandle, OCI_HTYPE_SPOOL, &count, NULL, OCI_ATTR_SPOOL_OPEN_COUNT, m_errorHandle) == OCI_SUCCESS)
+			statistics.m_openCount = count;
+		if (OCIAttrGet (m_poolHandle, OCI_HTYPE_SPOOL, &count, NULL, OCI_ATTR_SPOOL_BUSY_COUNT, m_errorHandle) == OCI_SUCCESS)
+			statistics.m_busyCount = count;
+	}
+	return statistics;
+}
+
+
+bool SessionPool::isPoolExhausted (OCIError *errorHandle)
+{
+	sb4 oraCode = 0;
+	TCHAR errorText [OCI_ERROR_MAXMSG_SIZE];
+	OCIErrorGet (errorHandle, 1, NULL, &oraCode, reinterpret_cast<unsigned char *> (errorText), sizeof (errorText), OCI_HTYPE_ERROR);
+	return (oraCode == ORA_POOL_NO_MORE_SESSIONS || oraCode == ORA_POOL_GET_TIMED_OUT);
+}
+
+
+void SessionPool::getSession (OCIError *errorHandle, OCISvcCtx **svcContextHandle)
+{
+	if (!m_isCreated)
+		throw (OraError(EC_POOL_NOT_SETUP, __TFILE__, __LINE__));
+
+	OCIEnv *envHandle = m_environment->GetHandle ();
+	unsigned int startTime = epl::System::GetTickCount ();
+	unsigned int waitTime = 0;
+	bool hasWaited = false;
+	int	result;
+
+	// every session is busy and the pool cannot grow
+	ub4 busyCount = 0;
+	if (OCIAttrGet (m_poolHandle, OCI_HTYPE_SPOOL, &busyCount, NULL, OCI_ATTR_SPOOL_BUSY_COUNT, errorHandle) == OCI_SUCCESS)
+		hasWaited = (busyCount >= m_sessionMax);
+
+	for (;;)
+	{
+		result = OCISessionGet (envHandle, errorHandle, svcContextHandle, NULL, m_poolName, m_poolNameLength, NULL, 0, NULL, NULL, NULL, OCI_SESSGET_SPOOL);
+		waitTime = epl::System::GetTickCount () - startTime;
+		if (result == OCI_SUCCESS_WITH_INFO)
+			result = OCI_SUCCESS;
+		if (result == OCI_SUCCESS || m_getTimeout == WAITTIME_INIFINITE || waitTime >= m_getTimeout || !isPoolExhausted (errorHandle))
+			break;
+
+		// wait for a session to be returned (other waiters may take it, so poll)
+		hasWaited = true;
+		unsigned int remaining = m_getTimeout - waitTime;
+		m_returnEvent.WaitForEvent (remaining < SESSION_POOL_POLL_INTERVAL ? remaining : SESSION_POOL_POLL_INTERVAL);
+	}
+
+	epl::LockObj lock (&m_statLock);
+	if (hasWaited)
+		m_statistics.m_waitCount++;
+	m_statistics.m_totalWaitTime += waitTime;
+	if (waitTime > m_statistics.m_maxWaitTime)
+		m_statistics.m_maxWaitTime = waitTime;
+
+	if (result == OCI_SUCCESS)
+		m_statistics.m_borrowCount++;
+	else if (m_getTimeout != WAITTIME_INIFINITE && isPoolExhausted (errorHandle))
+	{
+		m_statistics.m_timeoutCount++;
+		throw (OraError(EC_TIMEOUT, __TFILE__, __LINE__, _T("no free session within %u ms"), m_getTimeout));
+	}
+	else
+		throw (OraError(result, errorHandle, __TFILE__, __LINE__));
+}
+
+
+int SessionPool::releaseSession (OCIError *errorHandle, OCISvcCtx *svcContextHandle)
+{
+	int result = OCISessionRelease (svcContextHandle, errorHandle, NULL, 0, OCI_DEFAULT);
+	m_returnEvent.SetEvent ();
+	return result;
+}
@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include "epParameter.h"
 #include "epConnection.h"
 #include "epOraError.h"
+#include "epAsyncOperation.h"
+#include "epAsyncReactor.h"
 
 #if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 #define new DEBUG_NEW
@@ -63,9 +65,11 @@ Statement::~Statement ()
 void Statement::initialize ()
 {
 	m_stmtHandle = NULL;
+	m_errorHandle = NULL;
 	m_isPrepared = false;
 	m_isExecuted = false;
 	m_stmtType = ST_UNKNOWN;
+	m_rowCount = 0;
 }
 
 
@@ -76,10 +80,16 @@ void Statement::cleanUp ()
 		OCIHandleFree (m_stmtHandle, OCI_HTYPE_STMT);
 		m_stmtHandle = NULL;
 	}
+	if (m_errorHandle)
+	{
+		OCIHandleFree (m_errorHandle, OCI_HTYPE_ERROR);
+		m_errorHandle = NULL;
+	}
 	for (Parameters::iterator i=m_parameters.begin (); i!=m_parameters.end (); ++i)
 		(*i)->ReleaseObj();
 	m_parameters.clear ();
 	m_parametersMap.clear();	
+	m_batchErrors.clear ();
 }
 
 
@@ -91,13 +101,17 @@ void Statement::prepare (const TCHAR *sqlStmt)
 
 	int	result;
 
-	result = OCIHandleAlloc (m_conn->m_envHandle,(void **) &m_stmtHandle,OCI_HTYPE_STMT,0,	NULL);
+	result = OCIHandleAlloc (m_conn->m_envHandle,(void **) &m_errorHandle,OCI_HTYPE_ERROR,0,	NULL);
+
+	if (result == OCI_SUCCESS)
+		result = OCIHandleAlloc (m_conn->m_envHandle,(void **) &m_stmtHandle,OCI_HTYPE_STMT,0,	NULL);
 
 	if (result == OCI_SUCCESS)
 	{
-		unsigned int sqlLen = epl::EpTString(sqlStmt).length();
+		m_sqlStmt = sqlStmt;
+		unsigned int sqlLen = m_sqlStmt.length();
 
-		result = OCIStmtPrepare (m_stmtHandle,m_conn->m_errorHandle,(text *) sqlStmt, sqlLen*sizeof(TCHAR), OCI_NTV_SYNTAX, OCI_DEFAULT);
+		result = OCIStmtPrepare (m_stmtHandle,m_errorHandle,(text *) sqlStmt, sqlLen*sizeof(TCHAR), OCI_NTV_SYNTAX, OCI_DEFAULT);
 	}
 	else
 		throw (OraError(result, m_conn->m_envHandle, __TFILE__, __LINE__));
@@ -105,7 +119,7 @@ void Statement::prepare (const TCHAR *sqlStmt)
 	if (result == OCI_SUCCESS)
 	{
 		unsigned short stmtType = 0;
-		result = OCIAttrGet (m_stmtHandle, OCI_HTYPE_STMT, &stmtType, NULL, OCI_ATTR_STMT_TYPE, m_conn->m_errorHandle);
+		result = OCIAttrGet (m_stmtHandle, OCI_HTYPE_STMT, &stmtType, NULL, OCI_ATTR_STMT_TYPE, m_errorHandle);
 		// returns 0 (ST_UNKNOWN) if sql statement is wrong
 		m_stmtType = (StatementTypesEnum) stmtType;
 	}
@@ -116,54 +130,269 @@ void Statement::prepare (const TCHAR *sqlStmt)
 		m_isExecuted = false;
 	}
 	else
-		throw (OraError(result, m_conn->m_errorHandle, __TFILE__, __LINE__));
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
 }
 
 
-void Statement::executePrepared ()
+void Statement::executePrepared (unsigned int rowCount, ExecuteModesEnum executeMode)
 {
-	EP_ASSERT (m_conn != NULL && m_isPrepared);
+	int result = tryExecutePrepared (rowCount, executeMode);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
+}
+
 
+Status Statement::TryExecute (unsigned int rowCount, ExecuteModesEnum executeMode)
+{
+	int result = tryExecutePrepared (rowCount, executeMode);
+	Status status (result, m_errorHandle);
+	status.m_rowCount = m_rowCount;
+	return (status);
+}
+
+
+int Statement::tryExecutePrepared (unsigned int rowCount, ExecuteModesEnum executeMode)
+{
 	int	result;
 	unsigned int iters;
+	unsigned int mode = beginExecute (rowCount, executeMode, iters);
 
-	iters = (m_stmtType == ST_SELECT) ? 0 : 1;
-	result = OCIStmtExecute (m_conn->m_svcContextHandle,m_stmtHandle, m_conn->m_errorHandle, iters,	0, NULL, NULL, OCI_DEFAULT);
+	// a non-blocking connection returns OCI_STILL_EXECUTING until the call completes
+	result = executeStep (iters, mode);
+	while (result == OCI_STILL_EXECUTING)
+	{
+		Sleep (ASYNC_REACTOR_POLL_INTERVAL);
+		result = executeStep (iters, mode);
+	}
+
+	return (completeExecute (result, mode));
+}
+
+
+AsyncOperation *Statement::ExecuteAsync (AsyncReactor &reactor, unsigned int rowCount, ExecuteModesEnum executeMode)
+{
+	ExecuteOperation *operation = EP_NEW ExecuteOperation (this, rowCount, executeMode);
+	try
+	{
+		reactor.submit (operation);
+	}
+	catch (...)
+	{
+		operation->ReleaseObj ();
+		throw;
+	}
+	return (operation);
+}
+
+
+unsigned int Statement::beginExecute (unsigned int rowCount, ExecuteModesEnum executeMode, unsigned int &retIters)
+{
+	EP_ASSERT (m_conn != NULL && m_isPrepared && rowCount > 0);
+
+	if (rowCount > 1)
+	{
+		for (Parameters::iterator i=m_parameters.begin (); i!=m_parameters.end (); ++i)
+			if ((*i)->m_arraySize < rowCount)
+				throw (OraError(EC_BAD_PARAM_TYPE, __TFILE__, __LINE__, (*i)->m_paramName.c_str ()));
+	}
+
+	unsigned int mode = OCI_DEFAULT;
+	if ((executeMode & EM_BATCH_ERRORS) && m_stmtType != ST_SELECT)
+		mode |= OCI_BATCH_ERRORS;
+	if (executeMode & EM_COMMIT_ON_SUCCESS)
+		mode |= OCI_COMMIT_ON_SUCCESS;
+
+	m_rowCount = 0;
+	m_batchErrors.clear ();
+
+	retIters = (m_stmtType == ST_SELECT) ? 0 : rowCount;
+	return (mode);
+}
+
+
+int Statement::executeStep (unsigned int iters, unsigned int mode)
+{
+	return (OCIStmtExecute (m_conn->m_svcContextHandle,m_stmtHandle, m_errorHandle, iters,	0, NULL, NULL, mode));
+}
+
+
+void Statement::endExecute (int result, unsigned int mode)
+{
+	result = completeExecute (result, mode);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
+}
+
+
+int Statement::completeExecute (int result, unsigned int mode)
+{
+	// failed rows of a batch are reported as success with info
+	if (result == OCI_SUCCESS_WITH_INFO && (mode & OCI_BATCH_ERRORS))
+	{
+		collectBatchErrors ();
+		result = OCI_SUCCESS;
+	}
 
 	if (result == OCI_SUCCESS)
+	{
 		m_isExecuted = true;
-	else
-		throw (OraError(result, m_conn->m_errorHandle, __TFILE__, __LINE__));
+		result = OCIAttrGet (m_stmtHandle, OCI_HTYPE_STMT, &m_rowCount, NULL, OCI_ATTR_ROW_COUNT, m_errorHandle);
+	}
+	return (result);
+}
+
+
+void Statement::collectBatchErrors ()
+{
+	int	result;
+	unsigned int errorCount = 0;
+
+	result = OCIAttrGet (m_stmtHandle, OCI_HTYPE_STMT, &errorCount, NULL, OCI_ATTR_NUM_DML_ERRORS, m_errorHandle);
+	if (result != OCI_SUCCESS)
+		throw (OraError(result, m_errorHandle, __TFILE__, __LINE__));
+	if (errorCount == 0)
+		return;
+
+	// the row errors are read out of the statement's error handle,
+	// so the reading itself reports into a separate one
+	OCIError *readErrorHandle = NULL;
+	OCIError *rowErrorHandle = NULL;
+
+	result = OCIHandleAlloc (m_conn->m_envHandle, (void **) &readErrorHandle, OCI_HTYPE_ERROR, 0, NULL);
+	if (result == OCI_SUCCESS)
+		result = OCIHandleAlloc (m_conn->m_envHandle, (void **) &rowErrorHandle, OCI_HTYPE_ERROR, 0, NULL);
+	if (result != OCI_SUCCESS)
+	{
+		if (readErrorHandle)
+			OCIHandleFree (readErrorHandle, OCI_HTYPE_ERROR);
+		throw (OraError(result, m_conn->m_envHandle, __TFILE__, __LINE__));
+	}
+
+	m_batchErrors.reserve (errorCount);
+	for (unsigned int i = 0; result == OCI_SUCCESS && i < errorCount; i++)
+	{
+		BatchError batchError;
+		TCHAR errorText [OCI_ERROR_MAXMSG_SIZE];
+
+		batchError.m_rowOffset = 0;
+		batchError.m_oraCode = 0;
+		errorText [0] = _T('\0');
+
+		result = OCIParamGet (m_errorHandle, OCI_HTYPE_ERROR, readErrorHandle, (void **) &rowErrorHandle, i);
+		if (result == OCI_SUCCESS)
+			result = OCIAttrGet (rowErrorHandle, OCI_HTYPE_ERROR, &batchError.m_rowOffset, NULL, OCI_ATTR_DML_ROW_OFFSET, readErrorHandle);
+		if (result == OCI_SUCCESS)
+		{
+			OCIErrorGet (rowErrorHandle, 1, NULL, reinterpret_cast<int*>(&batchError.m_oraCode), reinterpret_cast<unsigned char *> (errorText), sizeof (errorText), OCI_HTYPE_ERROR);
+			batchError.m_message = errorText;
+			m_batchErrors.push_back (batchError);
+		}
+	}
+
+	if (result != OCI_SUCCESS)
+	{
+		OraError error (result, readErrorHandle, __TFILE__, __LINE__);
+		OCIHandleFree (rowErrorHandle, OCI_HTYPE_ERROR);
+		OCIHandleFree (readErrorHandle, OCI_HTYPE_ERROR);
+		throw (error);
+	}
+	OCIHandleFree (rowErrorHandle, OCI_HTYPE_ERROR);
+	OCIHandleFree (readErrorHandle, OCI_HTYPE_ERROR);
+}
+
+
+ResultSet* Statement::Select (unsigned int fetchSize, FetchModesEnum fetchMode)
+{
+	ResultSet *resultSet = NULL;
+	OCIError *errorHandle = NULL;
+	int result = trySelectPrepared (resultSet, fetchSize, fetchMode, errorHandle);
+	if (result != OCI_SUCCESS)
+	{
+		// the error has to be taken before the result set frees its error handle
+		OraError error (result, errorHandle, __TFILE__, __LINE__);
+		if (resultSet)
+			resultSet->ReleaseObj();
+		throw (error);
+	}
+	return (resultSet);
+}
+
+
+Status Statement::TrySelect (ResultSet *&retResultSet, unsigned int fetchSize, FetchModesEnum fetchMode)
+{
+	OCIError *errorHandle = NULL;
+	int result = trySelectPrepared (retResultSet, fetchSize, fetchMode, errorHandle);
+	Status status (result, errorHandle);
+	if (retResultSet)
+		status.m_rowCount = retResultSet->GetRowsFetched ();
+	if (result != OCI_SUCCESS && retResultSet)
+	{
+		retResultSet->ReleaseObj();
+		retResultSet = NULL;
+	}
+	return (status);
 }
 
 
-ResultSet* Statement::Select ()
+int Statement::trySelectPrepared (ResultSet *&retResultSet, unsigned int fetchSize, FetchModesEnum fetchMode, OCIError *&retErrorHandle)
 {
 	EP_ASSERT (m_isPrepared && m_stmtType == ST_SELECT);
 
-	Execute ();
-	ResultSet *resultSet = EP_NEW ResultSet (m_stmtHandle,m_conn);
+	retResultSet = NULL;
+	retErrorHandle = m_errorHandle;
+	int result = tryExecutePrepared (1, EM_DEFAULT);
+	if (result != OCI_SUCCESS)
+		return (result);
+
+	retResultSet = EP_NEW ResultSet (m_stmtHandle,m_conn,fetchSize,fetchMode);
 	try
 	{
-		resultSet->fetchRows();
-		return (resultSet);
+		if (fetchMode != FM_BOUND_ROWS)
+			result = retResultSet->tryFetchRows (retErrorHandle);
 	}
 	catch (...)
 	{
-		if (resultSet) 
-			resultSet->ReleaseObj();
+		retResultSet->ReleaseObj();
+		retResultSet = NULL;
 		throw;
 	}
+	return (result);
 }
 
 
-Parameter& Statement::Bind (const TCHAR *name,DataTypesEnum type)
+Parameter& Statement::Bind (const TCHAR *name,DataTypesEnum type, unsigned int arraySize, unsigned int maxTextLength)
 {
 	// prerequisites
 	EP_ASSERT (name);
 
-	// could throw an exception
-	Parameter *param = new Parameter (this,	name,type,FETCH_SIZE);
+	// reuse the buffers of a previous binding
+	ParametersMap::iterator i = m_parametersMap.find (epl::EpTString(name));
+	if (i != m_parametersMap.end () && i->second->isCompatible (type, arraySize, maxTextLength))
+	{
+		i->second->m_currentCell = 0;
+		return (*(i->second));
+	}
+
+	// could throw an exception (binding the name again replaces the previous binding)
+	Parameter *param = new Parameter (this,	name,type,FETCH_SIZE,arraySize,maxTextLength);
+
+	if (i != m_parametersMap.end ())
+	{
+		// the incompatible parameter gives its place to the new one
+		Parameter *oldParam = i->second;
+		for (Parameters::iterator j = m_parameters.begin (); j != m_parameters.end (); ++j)
+		{
+			if (*j == oldParam)
+			{
+				*j = param;
+				break;
+			}
+		}
+		i->second = param;
+		oldParam->ReleaseObj();
+		return (*param);
+	}
+
 	try
 	{
 		m_parameters.push_back (param);
@@ -178,6 +407,15 @@ Parameter& Statement::Bind (const TCHAR *name,DataTypesEnum type)
 }
 
 
+void Statement::resetParameters ()
+{
+	for (Parameters::iterator i=m_parameters.begin (); i!=m_parameters.end (); ++i)
+		(*i)->reset ();
+	m_rowCount = 0;
+	m_batchErrors.clear ();
+}
+
+
 Parameter& Statement::operator [] (const TCHAR *paramName)
 {
 	ParametersMap::iterator i = m_parametersMap.find (epl::EpTString(paramName));